@@ -755,6 +755,18 @@ extern SDL_DECLSPEC MIX_Audio * SDLCALL MIX_LoadAudioNoCopy(MIX_Mixer *mixer, co
  * - `MIX_PROP_AUDIO_LOAD_PREDECODE_BOOLEAN`: true if SDL_mixer should fully
  *   decode and decompress the data before returning. Otherwise it will be
  *   stored in its original state and decompressed on demand.
+ * - `MIX_PROP_AUDIO_LOAD_PREDECODE_MAX_MILLISECONDS_NUMBER`: if greater than
+ *   zero, audio with a known duration of no more than this many milliseconds
+ *   is predecoded, as if `MIX_PROP_AUDIO_LOAD_PREDECODE_BOOLEAN` were true.
+ *   This is useful for short MIDI or tracker jingles, which otherwise have to
+ *   be synthesized again every time they play. Default 0.
+ * - `MIX_PROP_AUDIO_LOAD_PREDECODE_LIMIT_MILLISECONDS_NUMBER`: if greater
+ *   than zero, predecoding stops after this many milliseconds of audio, and
+ *   the rest of the data is discarded. This lets audio that loops forever
+ *   (which is otherwise never predecoded) be cached: render the intro and one
+ *   pass through the loop, then loop that region with
+ *   `MIX_PROP_PLAY_LOOP_START_MILLISECOND_NUMBER` at playback time. Default
+ *   0.
  * - `MIX_PROP_AUDIO_LOAD_PREFERRED_MIXER_POINTER`: a pointer to a MIX_Mixer,
  *   in case steps can be made to match its format when decoding. Optional.
  * - `MIX_PROP_AUDIO_LOAD_SKIP_METADATA_TAGS_BOOLEAN`: true to skip parsing
@@ -792,6 +804,8 @@ extern SDL_DECLSPEC MIX_Audio * SDLCALL MIX_LoadAudioWithProperties(SDL_Properti
 #define MIX_PROP_AUDIO_LOAD_IOSTREAM_POINTER "SDL_mixer.audio.load.iostream"
 #define MIX_PROP_AUDIO_LOAD_CLOSEIO_BOOLEAN "SDL_mixer.audio.load.closeio"
 #define MIX_PROP_AUDIO_LOAD_PREDECODE_BOOLEAN "SDL_mixer.audio.load.predecode"
+#define MIX_PROP_AUDIO_LOAD_PREDECODE_MAX_MILLISECONDS_NUMBER "SDL_mixer.audio.load.predecode_max_milliseconds"
+#define MIX_PROP_AUDIO_LOAD_PREDECODE_LIMIT_MILLISECONDS_NUMBER "SDL_mixer.audio.load.predecode_limit_milliseconds"
 #define MIX_PROP_AUDIO_LOAD_PREFERRED_MIXER_POINTER "SDL_mixer.audio.load.preferred_mixer"
 #define MIX_PROP_AUDIO_LOAD_SKIP_METADATA_TAGS_BOOLEAN "SDL_mixer.audio.load.skip_metadata_tags"
 #define MIX_PROP_AUDIO_LOAD_IGNORE_LOOPS_BOOLEAN "SDL_mixer.audio.load.ignore_loops"
@@ -977,6 +991,29 @@ extern SDL_DECLSPEC MIX_Audio * SDLCALL MIX_CreateSineWaveAudio(MIX_Mixer *mixer
  *   out of sound to generate. This isn't necessarily always known to
  *   SDL_mixer, though.
  *
+ * SDL_mixer also records how long loading the audio took, to help track down
+ * slow startups. All times are in nanoseconds:
+ *
+ * - `MIX_PROP_AUDIO_LOAD_PROFILE_TOTAL_NS_NUMBER`: the whole load.
+ * - `MIX_PROP_AUDIO_LOAD_PROFILE_TAGS_NS_NUMBER`: scanning for metadata tags
+ *   (ID3, APE, etc).
+ * - `MIX_PROP_AUDIO_LOAD_PROFILE_PROBE_NS_NUMBER`: trying decoders until one
+ *   accepted the data, including the one that did.
+ * - `MIX_PROP_AUDIO_LOAD_PROFILE_DECODERS_STRING`: each decoder tried, in
+ *   order, with the time it took, like "WAV=1200,FLAC=3400,MP3=1500000".
+ * - `MIX_PROP_AUDIO_LOAD_PROFILE_SEEK_TABLE_NS_NUMBER`: building a seek table,
+ *   for decoders that scan the whole file to make one (like MP3). This is
+ *   also counted in the probe time. Zero for other formats.
+ * - `MIX_PROP_AUDIO_LOAD_PROFILE_PREDECODE_NS_NUMBER`: decoding the audio up
+ *   front, if it was predecoded.
+ * - `MIX_PROP_AUDIO_LOAD_PROFILE_PRECACHE_NS_NUMBER`: reading the file into
+ *   RAM, if it wasn't predecoded or loaded on demand.
+ * - `MIX_PROP_AUDIO_LOAD_PROFILE_BYTES_READ_NUMBER`: bytes read from the
+ *   SDL_IOStream during the load, by all of the above. If metadata tags were
+ *   skipped, this is estimated from how far each phase moved the stream.
+ *
+ * Totals across all loads are available from MIX_GetLoadStats().
+ *
  * Other properties, documented with MIX_LoadAudioWithProperties(), may also
  * be present.
  *
@@ -1004,6 +1041,14 @@ extern SDL_DECLSPEC SDL_PropertiesID SDLCALL MIX_GetAudioProperties(MIX_Audio *a
 #define MIX_PROP_METADATA_YEAR_NUMBER "SDL_mixer.metadata.year"
 #define MIX_PROP_METADATA_DURATION_FRAMES_NUMBER "SDL_mixer.metadata.duration_frames"
 #define MIX_PROP_METADATA_DURATION_INFINITE_BOOLEAN "SDL_mixer.metadata.duration_infinite"
+#define MIX_PROP_AUDIO_LOAD_PROFILE_TOTAL_NS_NUMBER "SDL_mixer.audio.load_profile.total_ns"
+#define MIX_PROP_AUDIO_LOAD_PROFILE_TAGS_NS_NUMBER "SDL_mixer.audio.load_profile.tags_ns"
+#define MIX_PROP_AUDIO_LOAD_PROFILE_PROBE_NS_NUMBER "SDL_mixer.audio.load_profile.probe_ns"
+#define MIX_PROP_AUDIO_LOAD_PROFILE_DECODERS_STRING "SDL_mixer.audio.load_profile.decoders"
+#define MIX_PROP_AUDIO_LOAD_PROFILE_SEEK_TABLE_NS_NUMBER "SDL_mixer.audio.load_profile.seek_table_ns"
+#define MIX_PROP_AUDIO_LOAD_PROFILE_PREDECODE_NS_NUMBER "SDL_mixer.audio.load_profile.predecode_ns"
+#define MIX_PROP_AUDIO_LOAD_PROFILE_PRECACHE_NS_NUMBER "SDL_mixer.audio.load_profile.precache_ns"
+#define MIX_PROP_AUDIO_LOAD_PROFILE_BYTES_READ_NUMBER "SDL_mixer.audio.load_profile.bytes_read"
 
 
 /**
@@ -3184,6 +3229,481 @@ extern SDL_DECLSPEC bool SDLCALL MIX_SetPostMixCallback(MIX_Mixer *mixer, MIX_Po
  */
 extern SDL_DECLSPEC int SDLCALL MIX_Generate(MIX_Mixer *mixer, void *buffer, int buflen);
 
+/**
+ * Render a mixer's output directly into a buffer, as fast as possible.
+ *
+ * This is meant for offline work, like baking a cutscene's audio or
+ * comparing a mix against known-good output in automated tests. It is like
+ * MIX_Generate(), but skips the mixer's output stream: tracks are mixed
+ * straight into `buffer`, in large blocks, without the extra conversion and
+ * buffering.
+ *
+ * Because of that, the output is always float32 (`SDL_AUDIO_F32`) with the
+ * channel count and sample rate requested when creating the mixer, no matter
+ * what format was requested there. MIX_SetMixerFrequencyRatio() is not
+ * applied. `buffer` must have room for `frames * channels` floats.
+ *
+ * The output is deterministic: given the same audio and the same changes to
+ * the mixer between calls, rendering produces the same bits no matter how
+ * many frames are requested per call. Audio from tracks playing an app's own
+ * SDL_AudioStream is only as deterministic as the data the app puts there.
+ *
+ * Don't mix calls to this function with MIX_Generate() on the same mixer;
+ * MIX_Generate() may have converted audio buffered that this function would
+ * skip over.
+ *
+ * To use more than one CPU core, render separate mixers on separate threads;
+ * each mixer is independent of the others.
+ *
+ * This function can not be used with mixers from MIX_CreateMixerDevice().
+ *
+ * \param mixer the mixer to render.
+ * \param buffer a pointer to a buffer to store float32 audio in.
+ * \param frames the number of sample frames to store in buffer.
+ * \returns the number of sample frames of mixed audio, discounting appended
+ *          silence, on success, or -1 on failure; call SDL_GetError() for
+ *          more information. All `frames` are written on success.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL_mixer 3.0.0.
+ *
+ * \sa MIX_CreateMixer
+ * \sa MIX_Generate
+ */
+extern SDL_DECLSPEC int SDLCALL MIX_RenderAudio(MIX_Mixer *mixer, float *buffer, int frames);
+
+
+/* Performance counters ... */
+
+/**
+ * A snapshot of a mixer's performance counters.
+ *
+ * The mixer keeps these counters up to date every time it generates a buffer
+ * of audio, whether for an audio device or MIX_Generate(). They are cheap to
+ * maintain, so they are always available. Totals accumulate from the mixer's
+ * creation, or the last call to MIX_ResetMixerStats(); divide them by
+ * `callbacks` for a per-buffer average.
+ *
+ * `last_load` and `max_load` compare the time spent generating a buffer to
+ * the time it takes to play it: 0.5f means the mixer used half its time
+ * budget. A value approaching 1.0f is a warning that the device might soon
+ * starve; each buffer that goes over 1.0f is counted in `underruns`. This is
+ * an estimate: it can't see delays outside the mixer, and for MIX_Generate()
+ * it only says whether mixing is keeping up with realtime.
+ *
+ * \since This struct is available since SDL_mixer 3.0.0.
+ *
+ * \sa MIX_GetMixerStats
+ * \sa MIX_ResetMixerStats
+ */
+typedef struct MIX_MixerStats
+{
+    Uint64 callbacks;            /**< number of buffers the mixer has generated. */
+    Uint64 last_callback_ns;     /**< time spent generating the most recent buffer. */
+    Uint64 average_callback_ns;  /**< average time spent generating a buffer. */
+    Uint64 max_callback_ns;      /**< most time spent generating a single buffer. */
+    Uint64 decode_ns;            /**< total time spent in decoders. */
+    Uint64 resample_ns;          /**< total time spent converting and resampling track audio. */
+    Uint64 mix_ns;               /**< total time spent mixing and spatializing tracks. */
+    Uint64 group_callback_ns;    /**< total time spent in group postmix callbacks. */
+    Uint64 postmix_ns;           /**< total time spent in the mixer's postmix callback. */
+    float last_load;             /**< time spent on the most recent buffer, as a fraction of its playback time. */
+    float max_load;              /**< highest `last_load` seen. */
+    int playing_tracks;          /**< tracks that were playing during the most recent buffer. */
+    int paused_tracks;           /**< tracks that were paused during the most recent buffer. */
+    int stopped_tracks;          /**< tracks that were stopped during the most recent buffer. */
+    Uint64 decoded_bytes;        /**< total bytes of audio produced by decoders. */
+    Uint64 reallocs;             /**< number of times the mixer had to grow a buffer while mixing. */
+    Uint64 underruns;            /**< number of buffers that took longer to generate than to play. */
+} MIX_MixerStats;
+
+/**
+ * Query a mixer's performance counters.
+ *
+ * This copies the current counters into `stats`. It does not reset them; use
+ * MIX_ResetMixerStats() for that.
+ *
+ * \param mixer the mixer to query.
+ * \param stats a pointer filled in with the mixer's current counters.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL_mixer 3.0.0.
+ *
+ * \sa MIX_ResetMixerStats
+ */
+extern SDL_DECLSPEC bool SDLCALL MIX_GetMixerStats(MIX_Mixer *mixer, MIX_MixerStats *stats);
+
+/**
+ * Reset a mixer's performance counters to zero.
+ *
+ * This is useful for measuring a specific stretch of time, or for clearing
+ * `max_callback_ns` and `max_load` after a known hitch, like loading a level.
+ *
+ * \param mixer the mixer to reset.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL_mixer 3.0.0.
+ *
+ * \sa MIX_GetMixerStats
+ */
+extern SDL_DECLSPEC bool SDLCALL MIX_ResetMixerStats(MIX_Mixer *mixer);
+
+/**
+ * A snapshot of a track's performance counters.
+ *
+ * These are the per-track version of MIX_MixerStats, to find which of many
+ * tracks is expensive: a slow decoder, a wild frequency ratio, or a slow app
+ * callback. Times are totals, accumulated from the track's creation or the
+ * last call to MIX_ResetTrackStats().
+ *
+ * The queued frame counts are not totals; they are how much audio is
+ * buffered inside the track right now, waiting to be mixed. Input frames are
+ * at the input's sample rate, output frames at the mixer's.
+ *
+ * \since This struct is available since SDL_mixer 3.0.0.
+ *
+ * \sa MIX_GetTrackStats
+ * \sa MIX_ResetTrackStats
+ */
+typedef struct MIX_TrackStats
+{
+    Uint64 decode_ns;          /**< total time spent in this track's decoder. */
+    Uint64 resample_ns;        /**< total time spent converting and resampling this track's audio. */
+    Uint64 callback_ns;        /**< total time spent in this track's raw, cooked and stopped callbacks. */
+    Uint64 mix_ns;             /**< total time spent mixing this track into its group. */
+    Uint64 decoded_bytes;      /**< total bytes of audio produced by this track's decoder. */
+    Uint64 mixed_frames;       /**< total sample frames mixed from this track. */
+    int input_queued_frames;   /**< sample frames decoded but not yet converted. */
+    int output_queued_frames;  /**< sample frames converted but not yet mixed. */
+} MIX_TrackStats;
+
+/**
+ * Query a track's performance counters.
+ *
+ * This copies the current counters into `stats`. It does not reset them; use
+ * MIX_ResetTrackStats() for that.
+ *
+ * \param track the track to query.
+ * \param stats a pointer filled in with the track's current counters.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL_mixer 3.0.0.
+ *
+ * \sa MIX_GetMixerStats
+ * \sa MIX_ResetTrackStats
+ */
+extern SDL_DECLSPEC bool SDLCALL MIX_GetTrackStats(MIX_Track *track, MIX_TrackStats *stats);
+
+/**
+ * Reset a track's performance counters to zero.
+ *
+ * \param track the track to reset.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL_mixer 3.0.0.
+ *
+ * \sa MIX_GetTrackStats
+ */
+extern SDL_DECLSPEC bool SDLCALL MIX_ResetTrackStats(MIX_Track *track);
+
+/**
+ * An estimate of how far behind the mixer the audible output is.
+ *
+ * Audio passes through several buffers on its way to the speakers: mixed
+ * audio waits in the mixer's output stream, then in the audio device's
+ * buffer. Each of these adds latency. All values are in sample frames at
+ * the mixer's sample rate (see MIX_GetMixerFormat()).
+ *
+ * These are SDL_mixer's and SDL's buffers only; whatever the operating
+ * system and hardware add after SDL hands off the audio is not visible here.
+ *
+ * \since This struct is available since SDL_mixer 3.0.0.
+ *
+ * \sa MIX_GetMixerLatency
+ */
+typedef struct MIX_MixerLatency
+{
+    int queued_frames;  /**< mixed audio waiting in the mixer's output stream. */
+    int device_frames;  /**< the audio device's buffer size. Zero for mixers from MIX_CreateMixer(). */
+    int total_frames;   /**< queued_frames plus device_frames: how long until audio mixed right now is heard. */
+    int start_frames;   /**< how long until a track started right now is expected to be heard. */
+} MIX_MixerLatency;
+
+/**
+ * Query a mixer's current output latency.
+ *
+ * Audio from a track started with MIX_PlayTrack() isn't mixed until the
+ * device asks for more audio, which might be up to a full device buffer
+ * later, and then it waits behind everything already mixed. `start_frames`
+ * estimates this as the time until the next mix, on average half a device
+ * buffer, plus `total_frames`. Rhythm games can use it to schedule sounds
+ * ahead of time, and everything can use it to tune buffer sizes; smaller
+ * device buffers (see SDL_HINT_AUDIO_DEVICE_SAMPLE_FRAMES) mean less latency.
+ *
+ * For mixers from MIX_CreateMixer(), the app decides when audio is played, so
+ * only the mixer's own buffering is reported.
+ *
+ * \param mixer the mixer to query.
+ * \param latency a pointer filled in with the mixer's current latency.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL_mixer 3.0.0.
+ *
+ * \sa MIX_GetTrackLatency
+ */
+extern SDL_DECLSPEC bool SDLCALL MIX_GetMixerLatency(MIX_Mixer *mixer, MIX_MixerLatency *latency);
+
+/**
+ * Query how far behind a track's playback position the audible output is.
+ *
+ * This is the track's own buffering, audio that has been decoded and
+ * converted but not yet mixed, plus the mixer's `total_frames` from
+ * MIX_GetMixerLatency(). Subtracting it from MIX_GetTrackPlaybackPosition()
+ * estimates the position that is actually being heard.
+ *
+ * The result is in sample frames at the mixer's sample rate, not the track's;
+ * convert with MIX_FramesToMS() and the mixer's format if needed.
+ *
+ * \param track the track to query.
+ * \returns the latency in sample frames, or -1 on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL_mixer 3.0.0.
+ *
+ * \sa MIX_GetMixerLatency
+ * \sa MIX_GetTrackPlaybackPosition
+ */
+extern SDL_DECLSPEC Sint64 SDLCALL MIX_GetTrackLatency(MIX_Track *track);
+
+/**
+ * Counts of heap allocations made while mixing.
+ *
+ * Steady-state mixing should not need to allocate memory: allocating on the
+ * audio thread can stall it long enough for the device to starve. With
+ * allocation tracking enabled, SDL_mixer counts every allocation made through
+ * SDL's allocator while a mixer is generating audio, sorted by what was
+ * running at the time.
+ *
+ * \since This struct is available since SDL_mixer 3.0.0.
+ *
+ * \sa MIX_SetAllocationTracking
+ * \sa MIX_GetAllocationStats
+ */
+typedef struct MIX_AllocationStats
+{
+    Uint64 mixer_allocations;     /**< allocations by the mixer itself, like growing its mixing buffers. */
+    Uint64 track_allocations;     /**< allocations while converting, resampling and buffering track audio. */
+    Uint64 decoder_allocations;   /**< allocations inside decoders, while decoding or seeking. */
+    Uint64 callback_allocations;  /**< allocations inside the app's callbacks. */
+    Uint64 allocated_bytes;       /**< total bytes requested by all of the above. */
+    const char *last_path;        /**< where the most recent allocation happened: "mixer", "track", "app callback", or a decoder's name. NULL if there haven't been any. */
+} MIX_AllocationStats;
+
+/**
+ * Enable or disable counting allocations made while mixing.
+ *
+ * This is a debugging tool, to verify that mixing is allocation-free once it
+ * reaches a steady state. When enabled, SDL_mixer wraps SDL's memory
+ * functions (see SDL_SetMemoryFunctions()) and counts any allocation made by
+ * a thread while it's mixing. Allocations made by other threads, or while
+ * loading audio, are not counted. Libraries that call the C runtime's
+ * malloc() directly, instead of going through SDL, can't be seen.
+ *
+ * If `fatal` is true, each allocation while mixing also logs where it came
+ * from and triggers an assertion, so a debugger stops right at the
+ * offending call.
+ *
+ * Enabling tracking resets the counts. Expect some allocations when tracks
+ * start playing, as buffers grow to their working size; reset the counts
+ * after that to check the steady state.
+ *
+ * Tracking adds a little overhead to every allocation in the process while
+ * it is enabled. When disabled, it costs nothing. It is disabled by
+ * MIX_Quit().
+ *
+ * \param enabled true to count allocations made while mixing, false to stop.
+ * \param fatal true to also log and assert on each allocation.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL_mixer 3.0.0.
+ *
+ * \sa MIX_GetAllocationStats
+ */
+extern SDL_DECLSPEC bool SDLCALL MIX_SetAllocationTracking(bool enabled, bool fatal);
+
+/**
+ * Query the allocations counted while mixing.
+ *
+ * \param stats a pointer filled in with the current counts.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL_mixer 3.0.0.
+ *
+ * \sa MIX_SetAllocationTracking
+ */
+extern SDL_DECLSPEC bool SDLCALL MIX_GetAllocationStats(MIX_AllocationStats *stats);
+
+/**
+ * Totals of the time and I/O spent loading audio.
+ *
+ * Every MIX_Audio records how long each phase of its own load took in its
+ * properties (see MIX_GetAudioProperties()); this sums those up across every
+ * load, including ones that failed, so a regression in startup time can be
+ * attributed to a phase before hunting for the files responsible.
+ *
+ * All times are in nanoseconds.
+ *
+ * \since This struct is available since SDL_mixer 3.0.0.
+ *
+ * \sa MIX_GetLoadStats
+ * \sa MIX_ResetLoadStats
+ */
+typedef struct MIX_LoadStats
+{
+    Uint64 loads;          /**< audio loaded successfully. */
+    Uint64 failed_loads;   /**< loads that failed. */
+    Uint64 total_ns;       /**< time spent in all loads, start to finish. */
+    Uint64 tags_ns;        /**< time spent scanning for metadata tags. */
+    Uint64 probe_ns;       /**< time spent trying decoders, including building seek tables. */
+    Uint64 seek_table_ns;  /**< time spent building seek tables. */
+    Uint64 predecode_ns;   /**< time spent predecoding audio. */
+    Uint64 precache_ns;    /**< time spent reading files into RAM. */
+    Uint64 bytes_read;     /**< bytes read from SDL_IOStreams while loading. */
+} MIX_LoadStats;
+
+/**
+ * Query the totals for all audio loaded so far.
+ *
+ * These count every call to MIX_LoadAudio() and friends since the first
+ * MIX_Init(), or the last call to MIX_ResetLoadStats().
+ *
+ * \param stats a pointer filled in with the current totals.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL_mixer 3.0.0.
+ *
+ * \sa MIX_ResetLoadStats
+ * \sa MIX_GetAudioProperties
+ */
+extern SDL_DECLSPEC bool SDLCALL MIX_GetLoadStats(MIX_LoadStats *stats);
+
+/**
+ * Reset the load totals to zero.
+ *
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL_mixer 3.0.0.
+ *
+ * \sa MIX_GetLoadStats
+ */
+extern SDL_DECLSPEC bool SDLCALL MIX_ResetLoadStats(void);
+
+/**
+ * The kinds of work reported to a MIX_TraceCallback.
+ *
+ * \since This enum is available since SDL_mixer 3.0.0.
+ *
+ * \sa MIX_SetMixerTraceCallback
+ */
+typedef enum MIX_TraceEvent
+{
+    MIX_TRACE_MIX,            /**< the mixer generating a buffer of audio. */
+    MIX_TRACE_TRACK,          /**< a track generating more audio: decoding, converting, fading and its raw callback. */
+    MIX_TRACE_DECODE,         /**< a track's decoder producing more audio. */
+    MIX_TRACE_GROUP_POSTMIX,  /**< a group's postmix callback. */
+    MIX_TRACE_SEEK            /**< a track's decoder seeking, to loop or to change the playback position. */
+} MIX_TraceEvent;
+
+/**
+ * A callback that fires as a mixer begins and ends each piece of work.
+ *
+ * Every event is reported twice: once with `begin` set to true, and again
+ * with it set to false when the work is done. Events nest: a
+ * MIX_TRACE_DECODE happens inside a MIX_TRACE_TRACK, which happens inside a
+ * MIX_TRACE_MIX.
+ *
+ * `timestamp_ns` comes from SDL_GetTicksNS(), so it can be lined up with
+ * other timing in the app. `track` and `group` identify what the work was
+ * for; either may be NULL if the event isn't about a specific track or
+ * group, and `group` is NULL for tracks that aren't in an app-created group.
+ *
+ * This callback runs with the mixer locked, usually on the mixing thread.
+ * MIX_TRACE_SEEK events run on whatever thread asked the track to seek. It
+ * is called often, so it should do as little as possible: append to a buffer
+ * and return.
+ *
+ * \param userdata an opaque pointer provided by the app for its personal use.
+ * \param mixer the mixer doing the work.
+ * \param event the kind of work.
+ * \param begin true when the work starts, false when it ends.
+ * \param timestamp_ns the time of the event, from SDL_GetTicksNS().
+ * \param track the track the work is for, or NULL.
+ * \param group the group the work is for, or NULL.
+ *
+ * \since This datatype is available since SDL_mixer 3.0.0.
+ *
+ * \sa MIX_SetMixerTraceCallback
+ */
+typedef void (SDLCALL *MIX_TraceCallback)(void *userdata, MIX_Mixer *mixer, MIX_TraceEvent event, bool begin, Uint64 timestamp_ns, MIX_Track *track, MIX_Group *group);
+
+/**
+ * Set a callback that traces a mixer's work, for external profilers.
+ *
+ * This is meant for lining up stalls on the mixing thread against an app's
+ * own timeline. See MIX_TraceCallback for details.
+ *
+ * Tracing is only available if SDL_mixer was built with the
+ * `SDLMIXER_TRACING` CMake option. Without it, the hooks compile to nothing,
+ * costing no time at all, and this function fails.
+ *
+ * Each mixer has a single trace callback. Setting a new one replaces the
+ * last; setting a NULL callback disables tracing for this mixer.
+ *
+ * \param mixer the mixer to trace.
+ * \param cb the function to call with trace events. May be NULL.
+ * \param userdata an opaque pointer provided to the callback for its own
+ *                 personal use.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL_mixer 3.0.0.
+ *
+ * \sa MIX_TraceCallback
+ */
+extern SDL_DECLSPEC bool SDLCALL MIX_SetMixerTraceCallback(MIX_Mixer *mixer, MIX_TraceCallback cb, void *userdata);
+
 
 /* Decode audio files directly without a mixer ... */
 
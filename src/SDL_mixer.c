@@ -88,6 +88,10 @@ static MIX_Audio *all_audios = NULL;
 static MIX_AudioDecoder *all_audiodecoders = NULL;
 static SDL_Mutex *global_lock = NULL;
 
+#if defined(SDL_SSE2_INTRINSICS)
+bool MIX_HasSSE2 = false;
+#endif
+
 #if defined(SDL_NEON_INTRINSICS) && SDL_MIXER_NEED_SCALAR_FALLBACK
 bool MIX_HasNEON = false;
 #endif
@@ -127,6 +131,108 @@ static void UnlockTrack(MIX_Track *track)
     SDL_UnlockAudioStream(track->output_stream);
 }
 
+// Allocation tracking: when enabled, we wrap SDL's memory functions and count anything allocated while a thread is
+//  mixing. A thread-local string names what that thread's mixing is doing right now, so we can say who allocated.
+static SDL_AtomicInt alloc_tracking;
+static bool alloc_tracking_fatal = false;
+static SDL_TLSID alloc_path_tls;
+static SDL_SpinLock alloc_stats_lock;
+static MIX_AllocationStats alloc_stats;
+static SDL_malloc_func alloc_orig_malloc = NULL;
+static SDL_calloc_func alloc_orig_calloc = NULL;
+static SDL_realloc_func alloc_orig_realloc = NULL;
+static SDL_free_func alloc_orig_free = NULL;
+static const char alloc_path_none[] = "";
+static const char alloc_path_mixer[] = "mixer";
+static const char alloc_path_track[] = "track";
+static const char alloc_path_callback[] = "app callback";
+
+static void CountAllocation(size_t size)
+{
+    if (!SDL_GetAtomicInt(&alloc_tracking)) {
+        return;
+    }
+
+    const char *path = (const char *) SDL_GetTLS(&alloc_path_tls);
+    if (!path) {
+        return;  // this thread isn't mixing right now.
+    }
+
+    SDL_LockSpinlock(&alloc_stats_lock);
+    if (path == alloc_path_mixer) {
+        alloc_stats.mixer_allocations++;
+    } else if (path == alloc_path_track) {
+        alloc_stats.track_allocations++;
+    } else if (path == alloc_path_callback) {
+        alloc_stats.callback_allocations++;
+    } else {
+        alloc_stats.decoder_allocations++;  // decoders use their own name as the path.
+    }
+    alloc_stats.allocated_bytes += size;
+    alloc_stats.last_path = path;
+    SDL_UnlockSpinlock(&alloc_stats_lock);
+
+    if (alloc_tracking_fatal) {
+        SDL_SetTLS(&alloc_path_tls, NULL, NULL);  // don't count whatever logging or asserting allocates.
+        SDL_LogError(SDL_LOG_CATEGORY_AUDIO, "SDL_mixer: %u byte allocation while mixing, in %s", (unsigned int) size, path);
+        SDL_assert_always(!"Heap allocation while mixing");
+        SDL_SetTLS(&alloc_path_tls, (void *) path, NULL);
+    }
+}
+
+static void * SDLCALL AllocTrackingMalloc(size_t size)
+{
+    CountAllocation(size);
+    return alloc_orig_malloc(size);
+}
+
+static void * SDLCALL AllocTrackingCalloc(size_t nmemb, size_t size)
+{
+    CountAllocation(nmemb * size);
+    return alloc_orig_calloc(nmemb, size);
+}
+
+static void * SDLCALL AllocTrackingRealloc(void *mem, size_t size)
+{
+    CountAllocation(size);
+    return alloc_orig_realloc(mem, size);
+}
+
+// Mark this thread as doing `path` until LeaveAllocPath. Only the mixer can start a path; everything else is only
+//  tracked when it happens inside mixing, so an app thread seeking a track or calling its stopped callback isn't counted.
+// Returns NULL if tracking is off, so LeaveAllocPath knows to leave things alone.
+static const char *EnterAllocPath(const char *path)
+{
+    if (!SDL_GetAtomicInt(&alloc_tracking)) {
+        return NULL;
+    }
+
+    const char *prev = (const char *) SDL_GetTLS(&alloc_path_tls);
+    if (prev || (path == alloc_path_mixer)) {
+        SDL_SetTLS(&alloc_path_tls, (void *) path, NULL);
+    }
+    return prev ? prev : alloc_path_none;
+}
+
+static void LeaveAllocPath(const char *prev)
+{
+    if (prev) {
+        SDL_SetTLS(&alloc_path_tls, (prev == alloc_path_none) ? NULL : (void *) prev, NULL);
+    }
+}
+
+static void DisableAllocationTracking(void)
+{
+    SDL_SetAtomicInt(&alloc_tracking, 0);
+
+    // only unhook if nobody else has wrapped the memory functions since; if they did, our wrappers just pass through.
+    SDL_malloc_func current_malloc = NULL;
+    SDL_GetMemoryFunctions(&current_malloc, NULL, NULL, NULL);
+    if (current_malloc == AllocTrackingMalloc) {
+        SDL_SetMemoryFunctions(alloc_orig_malloc, alloc_orig_calloc, alloc_orig_realloc, alloc_orig_free);
+    }
+}
+
 static bool CheckInitialized(void)
 {
     if (!mixer_initialized) {
@@ -225,7 +331,11 @@ static void TrackStopped(MIX_Track *track)
     SDL_assert(track->state != MIX_STATE_STOPPED);  // shouldn't be already stopped at this point.
     track->state = MIX_STATE_STOPPED;
     if (track->stopped_callback) {
+        const char *prev_alloc_path = EnterAllocPath(alloc_path_callback);
+        const Uint64 start = SDL_GetPerformanceCounter();
         track->stopped_callback(track->stopped_callback_userdata, track);
+        track->counters.callback_ticks += SDL_GetPerformanceCounter() - start;
+        LeaveAllocPath(prev_alloc_path);
     }
     if (track->fire_and_forget) {
         SDL_assert(!track->stopped_callback);  // these shouldn't have stopped callbacks.
@@ -302,13 +412,31 @@ static bool DecodeMore(MIX_Track *track, int bytes_needed)
     SDL_assert(track->input_audio != NULL);
 
     bool retval = true;
-    while (SDL_GetAudioStreamAvailable(track->input_stream) < bytes_needed) {
+    const int available = SDL_GetAudioStreamAvailable(track->input_stream);
+    if (available >= bytes_needed) {
+        return true;
+    }
+
+    MIX_MixerCounters *counters = &track->mixer->counters;
+    MIX_TRACE(track->mixer, MIX_TRACE_DECODE, true, track, track->group);
+    const char *prev_alloc_path = EnterAllocPath(track->input_audio->decoder->name);
+    const Uint64 start = SDL_GetPerformanceCounter();
+    do {
         if (!track->input_audio->decoder->decode(track->decoder_userdata, track->input_stream)) {
             SDL_FlushAudioStream(track->input_stream);  // make sure we read _everything_ now.
             retval = false;
             break;
         }
-    }
+    } while (SDL_GetAudioStreamAvailable(track->input_stream) < bytes_needed);
+
+    const Uint64 elapsed = SDL_GetPerformanceCounter() - start;
+    LeaveAllocPath(prev_alloc_path);
+    const Uint64 decoded = (Uint64) SDL_max(SDL_GetAudioStreamAvailable(track->input_stream) - available, 0);
+    counters->decode_ticks += elapsed;
+    counters->decoded_bytes += decoded;
+    track->counters.decode_ticks += elapsed;
+    track->counters.decoded_bytes += decoded;
+    MIX_TRACE(track->mixer, MIX_TRACE_DECODE, false, track, track->group);
 
     return retval;
 }
@@ -326,6 +454,46 @@ static int FillSilenceFrames(MIX_Track *track, void *buffer, int channels, int b
     return br;
 }
 
+// Some decoders (synthesizers, mostly) can save their complete state and put it back much faster than they can
+//  seek. For those, we keep a snapshot at the loop point, so looping or restarting there doesn't re-render anything.
+static void FreeTrackSnapshot(MIX_Track *track)
+{
+    if (track->snapshot) {
+        track->input_audio->decoder->free_snapshot(track->snapshot);
+        track->snapshot = NULL;
+    }
+}
+
+static void PrepareTrackSnapshot(MIX_Track *track, Uint64 frame)
+{
+    const MIX_Decoder *decoder = track->input_audio->decoder;
+    if (!decoder->snapshot || (track->snapshot && (track->snapshot_frame == frame))) {
+        return;  // not supported, or we already have it.
+    }
+
+    FreeTrackSnapshot(track);
+    if (decoder->seek(track->decoder_userdata, frame)) {
+        track->snapshot = decoder->snapshot(track->decoder_userdata);  // if this fails, we'll just seek like any other decoder.
+        track->snapshot_frame = frame;
+    }
+}
+
+static bool SeekTrackDecoder(MIX_Track *track, Uint64 frame)
+{
+    const MIX_Decoder *decoder = track->input_audio->decoder;
+    bool retval;
+    MIX_TRACE(track->mixer, MIX_TRACE_SEEK, true, track, track->group);
+    const char *prev_alloc_path = EnterAllocPath(decoder->name);
+    if (track->snapshot && (track->snapshot_frame == frame) && decoder->restore(track->decoder_userdata, track->snapshot)) {
+        retval = true;
+    } else {
+        retval = decoder->seek(track->decoder_userdata, frame);
+    }
+    LeaveAllocPath(prev_alloc_path);
+    MIX_TRACE(track->mixer, MIX_TRACE_SEEK, false, track, track->group);
+    return retval;
+}
+
 // This is called every time we try to pull more from a track's output_stream.
 // We generate more audio here on-demand, either from a decoder, or pulling
 // from another audio stream.
@@ -341,6 +509,11 @@ static void SDLCALL TrackGetCallback(void *userdata, SDL_AudioStream *stream, in
         return;  // paused or stopped, don't make progress.
     }
 
+    MIX_MixerCounters *counters = &track->mixer->counters;
+    const Uint64 callback_start = SDL_GetPerformanceCounter();
+    MIX_TRACE(track->mixer, MIX_TRACE_TRACK, true, track, track->group);
+    const char *prev_alloc_path = EnterAllocPath(alloc_path_track);
+
     SDL_assert(track->output_spec.format == SDL_AUDIO_F32);
     SDL_assert(track->output_spec.freq == track->mixer->spec.freq);
 
@@ -354,10 +527,14 @@ static void SDLCALL TrackGetCallback(void *userdata, SDL_AudioStream *stream, in
         void *ptr = SDL_realloc(track->input_buffer, additional_amount);
         if (!ptr) {   // uhoh.
             TrackStopped(track);
+            counters->track_callback_ticks += SDL_GetPerformanceCounter() - callback_start;
+            LeaveAllocPath(prev_alloc_path);
+            MIX_TRACE(track->mixer, MIX_TRACE_TRACK, false, track, track->group);
             return;  // not much to be done, we're out of memory!
         }
         track->input_buffer = (float *) ptr;
         track->input_buffer_len = additional_amount;
+        counters->reallocs++;
     }
 
     float *pcm = track->input_buffer;  // we always work in float32 format.
@@ -380,7 +557,11 @@ static void SDLCALL TrackGetCallback(void *userdata, SDL_AudioStream *stream, in
             if (track->input_audio) {
                 DecodeMore(track, bytes_remaining);
             }
+            const Uint64 convert_start = SDL_GetPerformanceCounter();
             br = SDL_GetAudioStreamData(track->input_stream, pcm, bytes_remaining);
+            const Uint64 convert_ticks = SDL_GetPerformanceCounter() - convert_start;
+            counters->convert_ticks += convert_ticks;
+            track->counters.convert_ticks += convert_ticks;
         }
 
         // if input_audio and input_stream are both NULL, there's nothing to play (maybe they changed out the input on us?), br will be zero and we'll go to end_of_audio=true.
@@ -426,7 +607,11 @@ static void SDLCALL TrackGetCallback(void *userdata, SDL_AudioStream *stream, in
             const int samples = frames_read * raw_channels;
 
             if (track->raw_callback) {
+                const char *prev_cb_alloc_path = EnterAllocPath(alloc_path_callback);
+                const Uint64 raw_start = SDL_GetPerformanceCounter();
                 track->raw_callback(track->raw_callback_userdata, track, &raw_spec, pcm, samples);
+                track->counters.callback_ticks += SDL_GetPerformanceCounter() - raw_start;
+                LeaveAllocPath(prev_cb_alloc_path);
             }
 
             ApplyFade(track, raw_channels, pcm, frames_read);
@@ -458,7 +643,7 @@ static void SDLCALL TrackGetCallback(void *userdata, SDL_AudioStream *stream, in
                 if (!track->input_audio) {  // can't loop on a streaming input, you're done.
                     track_stopped = true;
                 } else {
-                    if (!track->input_audio->decoder->seek(track->decoder_userdata, track->loop_start)) {
+                    if (!SeekTrackDecoder(track, track->loop_start)) {
                         track_stopped = true;  // uhoh, can't seek! Abandon ship!
                     } else {
                         track->position = track->loop_start;
@@ -475,6 +660,10 @@ static void SDLCALL TrackGetCallback(void *userdata, SDL_AudioStream *stream, in
             }
         }
     }
+
+    counters->track_callback_ticks += SDL_GetPerformanceCounter() - callback_start;
+    LeaveAllocPath(prev_alloc_path);
+    MIX_TRACE(track->mixer, MIX_TRACE_TRACK, false, track, track->group);
 }
 
 static void MixSpatializedFloat32Audio(float *dst, const float *src, const int samples, const int output_channels, const float *panning, const int *speakers, const float gain)
@@ -534,15 +723,19 @@ static void MixFloat32Audio(float *dst, const float *src, const int buffer_size,
     }
 }
 
-// SDL calls this function from the audio device thread as more data is needed the mixer.
-static void SDLCALL MixerCallback(void *userdata, SDL_AudioStream *stream, int additional_amount, int total_amount)
+// Mix `additional_amount` bytes of float32 audio, in mixer->spec, from every track. If `output` is NULL, this mixes into
+//  the mixer's own scratch space. Returns a pointer to the mixed audio, or NULL if we ran out of memory.
+// The mixer is locked when calling this.
+static float *MixAudio(MIX_Mixer *mixer, float *output, int additional_amount)
 {
-    MIX_Mixer *mixer = (MIX_Mixer *) userdata;
     mixer->actual_mixed_bytes = 0;
 
-    if (additional_amount == 0) {
-        return;  // nothing to actually do yet. This was a courtesy call; the stream still has enough buffered.
-    }
+    MIX_MixerCounters *counters = &mixer->counters;
+    const Uint64 callback_start = SDL_GetPerformanceCounter();
+    Uint64 now;
+    MIX_TRACE(mixer, MIX_TRACE_MIX, true, NULL, NULL);
+    const char *prev_alloc_path = EnterAllocPath(alloc_path_mixer);
+    counters->playing_tracks = counters->paused_tracks = counters->stopped_tracks = 0;
 
     // it should be asking for float data...
     SDL_assert((additional_amount % sizeof (float)) == 0);
@@ -552,20 +745,28 @@ static void SDLCALL MixerCallback(void *userdata, SDL_AudioStream *stream, int a
 
     // do we need to grow our buffer?
     const bool skip_group_mixing = !mixer->all_groups || !mixer->all_groups->next;
-    const int alloc_multiplier = skip_group_mixing ? 2 : 3;
+    const int alloc_multiplier = 1 + (skip_group_mixing ? 0 : 1) + (output ? 0 : 1);
     const int alloc_size = additional_amount * alloc_multiplier;
     if ((unsigned)alloc_size > mixer->mix_buffer_allocation) {
         void *ptr = SDL_realloc(mixer->mix_buffer, alloc_size);
         if (!ptr) {   // uhoh.
-            return;  // not much to be done, we're out of memory!
+            LeaveAllocPath(prev_alloc_path);
+            MIX_TRACE(mixer, MIX_TRACE_MIX, false, NULL, NULL);
+            return NULL;  // not much to be done, we're out of memory!
         }
         mixer->mix_buffer = (float *) ptr;
         mixer->mix_buffer_allocation = alloc_size;
+        counters->reallocs++;
     }
 
     float *getbuf = mixer->mix_buffer;
-    float *final_mixbuf = getbuf + (additional_amount / sizeof (float));
-    float *group_mixbuf = skip_group_mixing ? final_mixbuf : (final_mixbuf + (additional_amount / sizeof (float)));
+    float *scratch = getbuf + (additional_amount / sizeof (float));
+    float *final_mixbuf = output;
+    if (!final_mixbuf) {
+        final_mixbuf = scratch;
+        scratch += additional_amount / sizeof (float);
+    }
+    float *group_mixbuf = skip_group_mixing ? final_mixbuf : scratch;
 
     SDL_memset(final_mixbuf, '\0', additional_amount);
 
@@ -584,11 +785,31 @@ static void SDLCALL MixerCallback(void *userdata, SDL_AudioStream *stream, int a
 
             track->currently_inuse = true;
 
+            switch (track->state) {
+                case MIX_STATE_PLAYING: counters->playing_tracks++; break;
+                case MIX_STATE_PAUSED: counters->paused_tracks++; break;
+                default: counters->stopped_tracks++; break;
+            }
+
+            // SDL_GetAudioStreamData() runs TrackGetCallback to decode, then resamples; whatever TrackGetCallback didn't spend is conversion.
             const int to_be_read = (additional_amount / SDL_AUDIO_FRAMESIZE(mixer->spec)) * SDL_AUDIO_FRAMESIZE(track->output_spec);
+            const Uint64 track_callback_ticks = counters->track_callback_ticks;
+            const char *prev_track_alloc_path = EnterAllocPath(alloc_path_track);
+            const Uint64 get_start = SDL_GetPerformanceCounter();
             const int br = SDL_GetAudioStreamData(track->output_stream, getbuf, to_be_read);
+            now = SDL_GetPerformanceCounter();
+            LeaveAllocPath(prev_track_alloc_path);
+            const Uint64 convert_ticks = (now - get_start) - (counters->track_callback_ticks - track_callback_ticks);
+            counters->convert_ticks += convert_ticks;
+            track->counters.convert_ticks += convert_ticks;
             if (br > 0) {
                 if (track->cooked_callback) {
+                    const char *prev_cb_alloc_path = EnterAllocPath(alloc_path_callback);
                     track->cooked_callback(track->cooked_callback_userdata, track, &track->output_spec, getbuf, br / sizeof (float));
+                    LeaveAllocPath(prev_cb_alloc_path);
+                    const Uint64 cooked_end = SDL_GetPerformanceCounter();
+                    track->counters.callback_ticks += cooked_end - now;
+                    now = cooked_end;
                 }
 
                 switch (track->spatialization_mode) {
@@ -614,6 +835,11 @@ static void SDLCALL MixerCallback(void *userdata, SDL_AudioStream *stream, int a
                         SDL_assert(!"Unexpected spatialization mode");
                         break;
                 }
+
+                const Uint64 mix_ticks = SDL_GetPerformanceCounter() - now;
+                counters->mix_ticks += mix_ticks;
+                track->counters.mix_ticks += mix_ticks;
+                track->counters.mixed_frames += (Uint64) (br / SDL_AUDIO_FRAMESIZE(track->output_spec));
             }
 
             track->currently_inuse = false;
@@ -630,19 +856,64 @@ static void SDLCALL MixerCallback(void *userdata, SDL_AudioStream *stream, int a
         }
 
         if (group->postmix_callback) {
+            MIX_TRACE(mixer, MIX_TRACE_GROUP_POSTMIX, true, NULL, group);
+            const char *prev_cb_alloc_path = EnterAllocPath(alloc_path_callback);
+            now = SDL_GetPerformanceCounter();
             group->postmix_callback(group->postmix_callback_userdata, group, &mixer->spec, group_mixbuf, additional_amount / sizeof (float));
+            counters->group_callback_ticks += SDL_GetPerformanceCounter() - now;
+            LeaveAllocPath(prev_cb_alloc_path);
+            MIX_TRACE(mixer, MIX_TRACE_GROUP_POSTMIX, false, NULL, group);
         }
 
         if (!skip_group_mixing) {
+            now = SDL_GetPerformanceCounter();
             MixFloat32Audio(final_mixbuf, group_mixbuf, group_bytes, 1.0f);  // we adjusted for mixer->gain for each track, don't adjust gain here, too.
+            counters->mix_ticks += SDL_GetPerformanceCounter() - now;
         }
     }
 
     if (mixer->postmix_callback) {
+        const char *prev_cb_alloc_path = EnterAllocPath(alloc_path_callback);
+        now = SDL_GetPerformanceCounter();
         mixer->postmix_callback(mixer->postmix_callback_userdata, mixer, &mixer->spec, final_mixbuf, additional_amount / sizeof (float));
+        counters->postmix_ticks += SDL_GetPerformanceCounter() - now;
+        LeaveAllocPath(prev_cb_alloc_path);
+    }
+
+    // if generating this buffer took longer than it takes to play it, the device is (or soon will be) starving.
+    const Uint64 elapsed = SDL_GetPerformanceCounter() - callback_start;
+    const Uint64 audio_ticks = ((Uint64) (additional_amount / SDL_AUDIO_FRAMESIZE(mixer->spec)) * SDL_GetPerformanceFrequency()) / (Uint64) mixer->spec.freq;
+    counters->callbacks++;
+    counters->last_callback_ticks = elapsed;
+    counters->total_callback_ticks += elapsed;
+    counters->max_callback_ticks = SDL_max(counters->max_callback_ticks, elapsed);
+    counters->last_load = audio_ticks ? ((float) elapsed / (float) audio_ticks) : 0.0f;
+    counters->max_load = SDL_max(counters->max_load, counters->last_load);
+    if (elapsed > audio_ticks) {
+        counters->underruns++;
+    }
+    counters->track_callback_ticks = 0;
+
+    LeaveAllocPath(prev_alloc_path);
+    MIX_TRACE(mixer, MIX_TRACE_MIX, false, NULL, NULL);
+
+    return final_mixbuf;
+}
+
+// SDL calls this function from the audio device thread as more data is needed the mixer.
+static void SDLCALL MixerCallback(void *userdata, SDL_AudioStream *stream, int additional_amount, int total_amount)
+{
+    MIX_Mixer *mixer = (MIX_Mixer *) userdata;
+    mixer->actual_mixed_bytes = 0;
+
+    if (additional_amount == 0) {
+        return;  // nothing to actually do yet. This was a courtesy call; the stream still has enough buffered.
     }
 
-    SDL_PutAudioStreamData(stream, final_mixbuf, additional_amount);
+    const float *mixed = MixAudio(mixer, NULL, additional_amount);
+    if (mixed) {
+        SDL_PutAudioStreamData(stream, mixed, additional_amount);
+    }
 }
 
 int MIX_Generate(MIX_Mixer *mixer, void *buffer, int buflen)
@@ -662,6 +933,41 @@ int MIX_Generate(MIX_Mixer *mixer, void *buffer, int buflen)
     return (mixer->actual_mixed_bytes / sizeof (float)) * SDL_AUDIO_BYTESIZE(output_spec.format);
 }
 
+int MIX_RenderAudio(MIX_Mixer *mixer, float *buffer, int frames)
+{
+    if (!CheckMixerParam(mixer)) {
+        return -1;
+    } else if (mixer->device_id) {
+        SDL_SetError("Can't use MIX_RenderAudio with a MIX_Mixer from MIX_CreateMixerDevice");
+        return -1;
+    } else if (!buffer) {
+        SDL_InvalidParamError("buffer");
+        return -1;
+    } else if (frames < 0) {
+        SDL_InvalidParamError("frames");
+        return -1;
+    }
+
+    // Work in blocks to keep the scratch buffers reasonable. Mixing is per-frame, so the block size doesn't change the output.
+    const int framesize = SDL_AUDIO_FRAMESIZE(mixer->spec);
+    const int channels = mixer->spec.channels;
+    int retval = 0;
+    for (int offset = 0; offset < frames; offset += MIX_RENDER_BLOCK_FRAMES) {
+        const int block_frames = SDL_min(frames - offset, MIX_RENDER_BLOCK_FRAMES);
+        LockMixer(mixer);
+        const float *mixed = MixAudio(mixer, buffer + ((size_t) offset * channels), block_frames * framesize);
+        const int mixed_frames = mixer->actual_mixed_bytes / framesize;
+        UnlockMixer(mixer);
+        if (!mixed) {
+            return -1;
+        } else if (mixed_frames > 0) {
+            retval = offset + mixed_frames;
+        }
+    }
+
+    return retval;
+}
+
 static void InitDecoders(void)
 {
     for (size_t i = 0; i < SDL_arraysize(decoders); i++) {
@@ -697,6 +1003,10 @@ bool MIX_Init(void)
         }
         #endif
 
+        #if defined(SDL_SSE2_INTRINSICS)
+        MIX_HasSSE2 = SDL_HasSSE2();
+        #endif
+
         #if defined(SDL_NEON_INTRINSICS) && !SDL_MIXER_NEED_SCALAR_FALLBACK
         if (!SDL_HasNEON()) {
             return SDL_SetError("Need NEON instructions but this CPU doesn't offer it");  // :(
@@ -742,6 +1052,8 @@ void MIX_Quit(void)
 
     QuitDecoders();
 
+    DisableAllocationTracking();
+
     SDL_DestroyMutex(global_lock);
     global_lock = NULL;
 
@@ -917,6 +1229,106 @@ void MIX_DestroyMixer(MIX_Mixer *mixer)
     SDL_free(mixer);
 }
 
+static Uint64 PerformanceTicksToNS(Uint64 ticks)
+{
+    const Uint64 freq = SDL_GetPerformanceFrequency();
+    return ((ticks / freq) * SDL_NS_PER_SECOND) + (((ticks % freq) * SDL_NS_PER_SECOND) / freq);
+}
+
+bool MIX_GetMixerStats(MIX_Mixer *mixer, MIX_MixerStats *stats)
+{
+    if (!CheckMixerParam(mixer)) {
+        return false;
+    } else if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    LockMixer(mixer);
+    const MIX_MixerCounters counters = mixer->counters;
+    UnlockMixer(mixer);
+
+    SDL_zerop(stats);
+    stats->callbacks = counters.callbacks;
+    stats->last_callback_ns = PerformanceTicksToNS(counters.last_callback_ticks);
+    stats->average_callback_ns = counters.callbacks ? PerformanceTicksToNS(counters.total_callback_ticks / counters.callbacks) : 0;
+    stats->max_callback_ns = PerformanceTicksToNS(counters.max_callback_ticks);
+    stats->decode_ns = PerformanceTicksToNS(counters.decode_ticks);
+    stats->resample_ns = PerformanceTicksToNS(counters.convert_ticks);
+    stats->mix_ns = PerformanceTicksToNS(counters.mix_ticks);
+    stats->group_callback_ns = PerformanceTicksToNS(counters.group_callback_ticks);
+    stats->postmix_ns = PerformanceTicksToNS(counters.postmix_ticks);
+    stats->last_load = counters.last_load;
+    stats->max_load = counters.max_load;
+    stats->playing_tracks = counters.playing_tracks;
+    stats->paused_tracks = counters.paused_tracks;
+    stats->stopped_tracks = counters.stopped_tracks;
+    stats->decoded_bytes = counters.decoded_bytes;
+    stats->reallocs = counters.reallocs;
+    stats->underruns = counters.underruns;
+    return true;
+}
+
+bool MIX_ResetMixerStats(MIX_Mixer *mixer)
+{
+    if (!CheckMixerParam(mixer)) {
+        return false;
+    }
+
+    LockMixer(mixer);
+    SDL_zero(mixer->counters);
+    UnlockMixer(mixer);
+    return true;
+}
+
+bool MIX_SetAllocationTracking(bool enabled, bool fatal)
+{
+    if (!CheckInitialized()) {
+        return false;
+    }
+
+    LockGlobal();
+    if (!enabled) {
+        DisableAllocationTracking();
+    } else {
+        SDL_malloc_func current_malloc = NULL;
+        SDL_calloc_func current_calloc = NULL;
+        SDL_realloc_func current_realloc = NULL;
+        SDL_free_func current_free = NULL;
+        SDL_GetMemoryFunctions(&current_malloc, &current_calloc, &current_realloc, &current_free);
+        if (current_malloc != AllocTrackingMalloc) {  // not already hooked?
+            alloc_orig_malloc = current_malloc;
+            alloc_orig_calloc = current_calloc;
+            alloc_orig_realloc = current_realloc;
+            alloc_orig_free = current_free;
+            SDL_SetMemoryFunctions(AllocTrackingMalloc, AllocTrackingCalloc, AllocTrackingRealloc, current_free);
+        }
+
+        SDL_LockSpinlock(&alloc_stats_lock);
+        SDL_zero(alloc_stats);
+        SDL_UnlockSpinlock(&alloc_stats_lock);
+
+        alloc_tracking_fatal = fatal;
+        SDL_SetAtomicInt(&alloc_tracking, 1);
+    }
+    UnlockGlobal();
+
+    return true;
+}
+
+bool MIX_GetAllocationStats(MIX_AllocationStats *stats)
+{
+    if (!CheckInitialized()) {
+        return false;
+    } else if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    SDL_LockSpinlock(&alloc_stats_lock);
+    SDL_copyp(stats, &alloc_stats);
+    SDL_UnlockSpinlock(&alloc_stats_lock);
+    return true;
+}
+
 SDL_PropertiesID MIX_GetMixerProperties(MIX_Mixer *mixer)
 {
     if (!CheckMixerParam(mixer)) {
@@ -956,33 +1368,60 @@ void MIX_UnlockMixer(MIX_Mixer *mixer)
     }
 }
 
-static const MIX_Decoder *PrepareDecoder(SDL_IOStream *io, MIX_Audio *audio)
+// Appends "NAME=ns" for one decoder we tried to the load profile's list, as long as it fits.
+static void AppendDecoderProbeTime(char *buf, size_t buflen, const MIX_Decoder *decoder, Uint64 ns)
+{
+    const size_t len = SDL_strlen(buf);
+    const int rc = SDL_snprintf(buf + len, buflen - len, "%s%s=%" SDL_PRIu64, (len > 0) ? "," : "", decoder->name, ns);
+    if ((rc < 0) || ((size_t) rc >= (buflen - len))) {
+        buf[len] = '\0';  // didn't fit, drop the partial entry.
+    }
+}
+
+static const MIX_Decoder *PrepareDecoder(SDL_IOStream *io, MIX_Audio *audio, Uint64 *probe_ns)
 {
     const char *decoder_name = SDL_GetStringProperty(audio->props, MIX_PROP_AUDIO_DECODER_STRING, NULL);
+    const MIX_Decoder *retval = NULL;
+    bool seek_failed = false;
+    char tried[512];
+    tried[0] = '\0';
 
     SDL_AudioSpec original_spec;
     SDL_copyp(&original_spec, &audio->spec);
 
+    const Uint64 probe_start = SDL_GetTicksNS();
     for (int i = 0; i < num_available_decoders; i++) {
         const MIX_Decoder *decoder = available_decoders[i];
         if (!decoder_name || (SDL_strcasecmp(decoder->name, decoder_name) == 0)) {
-            if (decoder->init_audio(io, &audio->spec, audio->props, &audio->duration_frames, &audio->decoder_userdata)) {
-                audio->decoder = decoder;
-                return decoder;
+            const Uint64 start = SDL_GetTicksNS();
+            const bool okay = decoder->init_audio(io, &audio->spec, audio->props, &audio->duration_frames, &audio->decoder_userdata);
+            AppendDecoderProbeTime(tried, sizeof (tried), decoder, SDL_GetTicksNS() - start);
+            if (okay) {
+                audio->decoder = retval = decoder;
+                break;
             } else if (SDL_SeekIO(io, 0, SDL_IO_SEEK_SET) < 0) {   // note this seeks to offset 0, because we're using an IoClamp.
                 SDL_SetError("Can't seek in stream to find proper decoder");
-                return NULL;
+                seek_failed = true;
+                break;
             }
             SDL_copyp(&audio->spec, &original_spec);  // reset this, in case init_audio changed it and then failed.
         }
     }
 
-    SDL_SetError("Audio data is in unknown/unsupported/corrupt format");
-    return NULL;
+    if (!retval && !seek_failed) {
+        SDL_SetError("Audio data is in unknown/unsupported/corrupt format");
+    }
+
+    *probe_ns = SDL_GetTicksNS() - probe_start;
+    SDL_SetStringProperty(audio->props, MIX_PROP_AUDIO_LOAD_PROFILE_DECODERS_STRING, tried);
+
+    return retval;
 }
 
-static void *DecodeWholeFile(MIX_Audio *audio, SDL_IOStream *io, size_t *decoded_len)
+// if max_frames is >= 0, stop after decoding that much, which makes it possible to predecode audio that loops forever.
+static void *DecodeWholeFile(MIX_Audio *audio, SDL_IOStream *io, Sint64 max_frames, size_t *decoded_len)
 {
+    const Sint64 max_bytes = (max_frames >= 0) ? (max_frames * SDL_AUDIO_FRAMESIZE(audio->spec)) : -1;
     size_t bytes_decoded = 0;
     Uint8 *decoded = NULL;
     SDL_AudioStream *stream = SDL_CreateAudioStream(&audio->spec, &audio->spec);   // !!! FIXME: if we're decoding up front, we might as well convert to float here too, right?
@@ -992,16 +1431,21 @@ static void *DecodeWholeFile(MIX_Audio *audio, SDL_IOStream *io, size_t *decoded
         if (decoder->init_track(audio->decoder_userdata, io, &audio->spec, audio->props, &track_userdata)) {
             if (decoder->seek(track_userdata, 0)) {
                 while (decoder->decode(track_userdata, stream)) {
-                    // spin.
+                    if ((max_bytes >= 0) && (SDL_GetAudioStreamAvailable(stream) >= max_bytes)) {
+                        break;  // that's all we wanted.
+                    }
                 }
             }
             decoder->quit_track(track_userdata);
 
             SDL_FlushAudioStream(stream);
-            const int available = SDL_GetAudioStreamAvailable(stream);
+            int available = SDL_GetAudioStreamAvailable(stream);
+            if ((max_bytes >= 0) && (available > max_bytes)) {
+                available = (int) max_bytes;
+            }
             decoded = (Uint8 *) SDL_malloc(available);   // !!! FIXME: SIMD align?
             if (decoded) {
-                const int rc = SDL_GetAudioStreamData(stream, decoded, available);
+                const int rc = SDL_GetAudioStreamData(stream, decoded, available);  // (if we're stopping short, the rest just gets thrown away with the stream.)
                 SDL_assert((rc < 0) || (rc == available));
                 if (rc < 0) {
                     SDL_free(decoded);
@@ -1018,6 +1462,70 @@ static void *DecodeWholeFile(MIX_Audio *audio, SDL_IOStream *io, size_t *decoded
     return decoded;
 }
 
+// Load profiling: every load records how long each phase took into the MIX_Audio's properties, and adds it to these
+//  totals, so a slow startup can be blamed on specific files and phases.
+static SDL_SpinLock load_stats_lock;
+static MIX_LoadStats load_stats;
+
+static void AccumulateLoadStats(const MIX_LoadStats *profile)
+{
+    SDL_LockSpinlock(&load_stats_lock);
+    load_stats.loads += profile->loads;
+    load_stats.failed_loads += profile->failed_loads;
+    load_stats.total_ns += profile->total_ns;
+    load_stats.tags_ns += profile->tags_ns;
+    load_stats.probe_ns += profile->probe_ns;
+    load_stats.seek_table_ns += profile->seek_table_ns;
+    load_stats.predecode_ns += profile->predecode_ns;
+    load_stats.precache_ns += profile->precache_ns;
+    load_stats.bytes_read += profile->bytes_read;
+    SDL_UnlockSpinlock(&load_stats_lock);
+}
+
+// How far `io` moved past `start`, for counting bytes read without an IoClamp. Zero if start is negative (unknown).
+static Uint64 StreamAdvance(SDL_IOStream *io, Sint64 start)
+{
+    const Sint64 pos = ((start >= 0) && io) ? SDL_TellIO(io) : -1;
+    return (pos > start) ? (Uint64) (pos - start) : 0;
+}
+
+static void SetLoadProfileProperties(SDL_PropertiesID props, const MIX_LoadStats *profile)
+{
+    SDL_SetNumberProperty(props, MIX_PROP_AUDIO_LOAD_PROFILE_TOTAL_NS_NUMBER, (Sint64) profile->total_ns);
+    SDL_SetNumberProperty(props, MIX_PROP_AUDIO_LOAD_PROFILE_TAGS_NS_NUMBER, (Sint64) profile->tags_ns);
+    SDL_SetNumberProperty(props, MIX_PROP_AUDIO_LOAD_PROFILE_PROBE_NS_NUMBER, (Sint64) profile->probe_ns);
+    SDL_SetNumberProperty(props, MIX_PROP_AUDIO_LOAD_PROFILE_SEEK_TABLE_NS_NUMBER, (Sint64) profile->seek_table_ns);
+    SDL_SetNumberProperty(props, MIX_PROP_AUDIO_LOAD_PROFILE_PREDECODE_NS_NUMBER, (Sint64) profile->predecode_ns);
+    SDL_SetNumberProperty(props, MIX_PROP_AUDIO_LOAD_PROFILE_PRECACHE_NS_NUMBER, (Sint64) profile->precache_ns);
+    SDL_SetNumberProperty(props, MIX_PROP_AUDIO_LOAD_PROFILE_BYTES_READ_NUMBER, (Sint64) profile->bytes_read);
+}
+
+bool MIX_GetLoadStats(MIX_LoadStats *stats)
+{
+    if (!CheckInitialized()) {
+        return false;
+    } else if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    SDL_LockSpinlock(&load_stats_lock);
+    SDL_copyp(stats, &load_stats);
+    SDL_UnlockSpinlock(&load_stats_lock);
+    return true;
+}
+
+bool MIX_ResetLoadStats(void)
+{
+    if (!CheckInitialized()) {
+        return false;
+    }
+
+    SDL_LockSpinlock(&load_stats_lock);
+    SDL_zero(load_stats);
+    SDL_UnlockSpinlock(&load_stats_lock);
+    return true;
+}
+
 MIX_Audio *MIX_LoadAudioWithProperties(SDL_PropertiesID props)  // lets you specify things like "here's a path to MIDI instrument data outside of this file", etc.
 {
     if (!CheckInitialized()) {
@@ -1026,7 +1534,9 @@ MIX_Audio *MIX_LoadAudioWithProperties(SDL_PropertiesID props)  // lets you spec
 
     SDL_IOStream *origio = (SDL_IOStream *) SDL_GetPointerProperty(props, MIX_PROP_AUDIO_LOAD_IOSTREAM_POINTER, NULL);
     MIX_Mixer *mixer = (MIX_Mixer *) SDL_GetPointerProperty(props, MIX_PROP_AUDIO_LOAD_PREFERRED_MIXER_POINTER, NULL);
-    const bool predecode = SDL_GetBooleanProperty(props, MIX_PROP_AUDIO_LOAD_PREDECODE_BOOLEAN, false);
+    bool predecode = SDL_GetBooleanProperty(props, MIX_PROP_AUDIO_LOAD_PREDECODE_BOOLEAN, false);
+    const Sint64 predecode_max_ms = SDL_GetNumberProperty(props, MIX_PROP_AUDIO_LOAD_PREDECODE_MAX_MILLISECONDS_NUMBER, 0);
+    const Sint64 predecode_limit_ms = SDL_GetNumberProperty(props, MIX_PROP_AUDIO_LOAD_PREDECODE_LIMIT_MILLISECONDS_NUMBER, 0);
     const bool closeio = SDL_GetBooleanProperty(props, MIX_PROP_AUDIO_LOAD_CLOSEIO_BOOLEAN, false);
     const bool ondemand = SDL_GetBooleanProperty(props, MIX_PROP_AUDIO_LOAD_ONDEMAND_BOOLEAN, false);
     const bool skip_metadata_tags = SDL_GetBooleanProperty(props, MIX_PROP_AUDIO_LOAD_SKIP_METADATA_TAGS_BOOLEAN, false);
@@ -1035,11 +1545,17 @@ MIX_Audio *MIX_LoadAudioWithProperties(SDL_PropertiesID props)  // lets you spec
     SDL_IOStream *io = NULL;
     SDL_IOStream *ioclamp = NULL;
     MIX_IoClamp clamp;
+    MIX_LoadStats profile;
+    Uint64 unclamped_bytes_read = 0;
     SDL_AudioSpec recommended_spec = { SDL_AUDIO_F32, 2, 48000 };  // a reasonable default if no mixer specified.
     if (mixer) {
         SDL_copyp(&recommended_spec, &mixer->spec);
     }
 
+    SDL_zero(clamp);
+    SDL_zero(profile);
+    const Uint64 load_start = SDL_GetTicksNS();
+
     MIX_Audio *audio = (MIX_Audio *) SDL_calloc(1, sizeof (*audio));
     if (!audio) {
         goto failed;
@@ -1068,8 +1584,10 @@ MIX_Audio *MIX_LoadAudioWithProperties(SDL_PropertiesID props)  // lets you spec
 
         const Sint64 orig_filelen = clamp.length;
 
+        const Uint64 tags_start = SDL_GetTicksNS();
         // !!! FIXME: currently we're ignoring return values from this function (see FIXME at the top of its code).
         MIX_ReadMetadataTags(io, audio->props, &clamp);
+        profile.tags_ns = SDL_GetTicksNS() - tags_start;
         if (SDL_SeekIO(io, 0, SDL_IO_SEEK_SET) < 0) {
             goto failed;
         }
@@ -1086,11 +1604,17 @@ MIX_Audio *MIX_LoadAudioWithProperties(SDL_PropertiesID props)  // lets you spec
     // sample rate, so it might as well do it at device format to avoid an unnecessary resample later).
     SDL_copyp(&audio->spec, &recommended_spec);
 
-    decoder = PrepareDecoder(io, audio);
+    // The IoClamp counts bytes read for the load profile. Without one, estimate from how far each phase moved the stream.
+    Sint64 phase_start = (!ioclamp && io) ? SDL_TellIO(io) : -1;
+    decoder = PrepareDecoder(io, audio, &profile.probe_ns);
+    unclamped_bytes_read += StreamAdvance(io, phase_start);
     if (!decoder) {
         goto failed;
     }
 
+    // decoders that build a seek table at load time report how long that took. It's part of the probe time, too.
+    profile.seek_table_ns = (Uint64) SDL_GetNumberProperty(audio->props, MIX_PROP_AUDIO_LOAD_PROFILE_SEEK_TABLE_NS_NUMBER, 0);
+
     audio_userdata = audio->decoder_userdata;  // less wordy access to this pointer.  :)
 
     // Go back to start of the SDL_IOStream, since we're either precaching, predecoding, or maybe just getting ready to actually play the thing.
@@ -1098,12 +1622,25 @@ MIX_Audio *MIX_LoadAudioWithProperties(SDL_PropertiesID props)  // lets you spec
         goto failed;
     }
 
+    phase_start = (!ioclamp && io) ? SDL_TellIO(io) : -1;
+
     // set this before predecoding might change `decoder` to the RAW implementation.
     SDL_SetStringProperty(audio->props, MIX_PROP_AUDIO_DECODER_STRING, decoder->name);
 
+    // short enough to just render once? This is mostly for MIDI and tracker jingles, which would otherwise be synthesized on every play.
+    if (!predecode && (predecode_max_ms > 0) && (audio->duration_frames >= 0)) {
+        predecode = (audio->duration_frames <= MIX_MSToFrames(audio->spec.freq, predecode_max_ms));
+    }
+
+    const Sint64 predecode_limit_frames = (predecode_limit_ms > 0) ? MIX_MSToFrames(audio->spec.freq, predecode_limit_ms) : -1;
+
     // if this is already raw data, predecoding is just going to make a copy of it, so skip it.
-    if (predecode && (decoder != &MIX_Decoder_RAW) && (audio->duration_frames != MIX_DURATION_INFINITE)) {
-        audio->precache = DecodeWholeFile(audio, io, &audio->precachelen);
+    //  Audio that loops forever can only be predecoded if we've been told where to stop.
+    if (predecode && (decoder != &MIX_Decoder_RAW) && ((audio->duration_frames != MIX_DURATION_INFINITE) || (predecode_limit_frames > 0))) {
+        const Uint64 predecode_start = SDL_GetTicksNS();
+        audio->precache = DecodeWholeFile(audio, io, predecode_limit_frames, &audio->precachelen);
+        profile.predecode_ns = SDL_GetTicksNS() - predecode_start;
+        unclamped_bytes_read += StreamAdvance(io, phase_start);
         if (!audio->precache) {
             goto failed;
         }
@@ -1116,7 +1653,11 @@ MIX_Audio *MIX_LoadAudioWithProperties(SDL_PropertiesID props)  // lets you spec
         audio->clamp_offset = -1;   // we're raw data now, any existing clamp is just nonsense now.
         audio->clamp_length = -1;
     } else if (!ondemand) {  // precache the audio data, so all decoding happens from a single buffer in RAM shared between tracks.
-        if ((audio->precache = SDL_LoadFile_IO(io, &audio->precachelen, false)) == NULL) {
+        const Uint64 precache_start = SDL_GetTicksNS();
+        audio->precache = SDL_LoadFile_IO(io, &audio->precachelen, false);
+        profile.precache_ns = SDL_GetTicksNS() - precache_start;
+        unclamped_bytes_read += StreamAdvance(io, phase_start);
+        if (!audio->precache) {
             goto failed;
         }
         audio->free_precache = true;
@@ -1129,6 +1670,12 @@ MIX_Audio *MIX_LoadAudioWithProperties(SDL_PropertiesID props)  // lets you spec
         io = ioclamp = NULL;
     }
 
+    profile.loads = 1;
+    profile.bytes_read = (Uint64) clamp.bytes_read + unclamped_bytes_read;
+    profile.total_ns = SDL_GetTicksNS() - load_start;
+    SetLoadProfileProperties(audio->props, &profile);
+    AccumulateLoadStats(&profile);
+
     if (closeio) {
         SDL_CloseIO(origio);
         origio = NULL;
@@ -1154,6 +1701,11 @@ MIX_Audio *MIX_LoadAudioWithProperties(SDL_PropertiesID props)  // lets you spec
     return audio;
 
 failed:
+    profile.failed_loads = 1;
+    profile.bytes_read = (Uint64) clamp.bytes_read + unclamped_bytes_read;
+    profile.total_ns = SDL_GetTicksNS() - load_start;
+    AccumulateLoadStats(&profile);
+
     if (decoder) {
         decoder->quit_audio(audio_userdata);
     }
@@ -1556,6 +2108,7 @@ void MIX_DestroyTrack(MIX_Track *track)
     SDL_DestroyAudioStream(track->output_stream);
 
     if (track->input_audio) {
+        FreeTrackSnapshot(track);
         track->input_audio->decoder->quit_track(track->decoder_userdata);
     }
 
@@ -1588,6 +2141,111 @@ SDL_PropertiesID MIX_GetTrackProperties(MIX_Track *track)
     return track->props;
 }
 
+bool MIX_GetTrackStats(MIX_Track *track, MIX_TrackStats *stats)
+{
+    if (!CheckTrackParam(track)) {
+        return false;
+    } else if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    SDL_zerop(stats);
+
+    // MixAudio updates the counters while holding the mixer lock, so take it too (mixer first, same order as MixAudio).
+    MIX_Mixer *mixer = track->mixer;
+    LockMixer(mixer);
+    LockTrack(track);
+    const MIX_TrackCounters counters = track->counters;
+    if (track->input_stream) {
+        SDL_AudioSpec spec;
+        if (SDL_GetAudioStreamFormat(track->input_stream, NULL, &spec)) {
+            stats->input_queued_frames = SDL_GetAudioStreamAvailable(track->input_stream) / SDL_AUDIO_FRAMESIZE(spec);
+        }
+    }
+    stats->output_queued_frames = SDL_GetAudioStreamAvailable(track->output_stream) / SDL_AUDIO_FRAMESIZE(track->output_spec);
+    UnlockTrack(track);
+    UnlockMixer(mixer);
+
+    stats->decode_ns = PerformanceTicksToNS(counters.decode_ticks);
+    stats->resample_ns = PerformanceTicksToNS(counters.convert_ticks);
+    stats->callback_ns = PerformanceTicksToNS(counters.callback_ticks);
+    stats->mix_ns = PerformanceTicksToNS(counters.mix_ticks);
+    stats->decoded_bytes = counters.decoded_bytes;
+    stats->mixed_frames = counters.mixed_frames;
+    return true;
+}
+
+bool MIX_ResetTrackStats(MIX_Track *track)
+{
+    if (!CheckTrackParam(track)) {
+        return false;
+    }
+
+    MIX_Mixer *mixer = track->mixer;
+    LockMixer(mixer);
+    LockTrack(track);
+    SDL_zero(track->counters);
+    UnlockTrack(track);
+    UnlockMixer(mixer);
+    return true;
+}
+
+// Everything is measured in sample frames at the mixer's rate, so the pieces can be added together.
+static void GetMixerLatency(MIX_Mixer *mixer, MIX_MixerLatency *latency)
+{
+    SDL_zerop(latency);
+
+    LockMixer(mixer);
+    const int queued = SDL_GetAudioStreamQueued(mixer->output_stream);
+    const int freq = mixer->spec.freq;
+    const int framesize = SDL_AUDIO_FRAMESIZE(mixer->spec);
+    UnlockMixer(mixer);
+
+    if (queued > 0) {
+        latency->queued_frames = queued / framesize;
+    }
+
+    // SDL plays one device buffer while it asks for the next, so count one of them. Device mixers only; for the others, the app controls this.
+    SDL_AudioSpec devspec;
+    int device_frames = 0;
+    if (mixer->device_id && SDL_GetAudioDeviceFormat(mixer->device_id, &devspec, &device_frames) && (device_frames > 0) && (devspec.freq > 0)) {
+        latency->device_frames = (int) (((Sint64) device_frames * freq) / devspec.freq);
+    }
+
+    latency->total_frames = latency->queued_frames + latency->device_frames;
+    latency->start_frames = latency->total_frames + (latency->device_frames / 2);  // on average, a new track waits half a device buffer to be mixed at all.
+}
+
+bool MIX_GetMixerLatency(MIX_Mixer *mixer, MIX_MixerLatency *latency)
+{
+    if (!CheckMixerParam(mixer)) {
+        return false;
+    } else if (!latency) {
+        return SDL_InvalidParamError("latency");
+    }
+
+    GetMixerLatency(mixer, latency);
+    return true;
+}
+
+Sint64 MIX_GetTrackLatency(MIX_Track *track)
+{
+    if (!CheckTrackParam(track)) {
+        return -1;
+    }
+
+    LockTrack(track);
+    const int available = SDL_GetAudioStreamAvailable(track->output_stream);
+    const int framesize = SDL_AUDIO_FRAMESIZE(track->output_spec);
+    UnlockTrack(track);
+
+    MIX_MixerLatency latency;
+    GetMixerLatency(track->mixer, &latency);
+
+    const Sint64 queued_frames = (available > 0) ? (available / framesize) : 0;
+    return queued_frames + latency.total_frames;
+}
+
 static bool MIX_SetTrackAudio_internal(MIX_Track *track, MIX_Audio *audio, SDL_IOStream *io, bool closeio)
 {
     SDL_assert(CheckTrackParam(track));
@@ -1623,6 +2281,7 @@ static bool MIX_SetTrackAudio_internal(MIX_Track *track, MIX_Audio *audio, SDL_I
     }
 
     if (track->input_audio) {
+        FreeTrackSnapshot(track);
         track->input_audio->decoder->quit_track(track->decoder_userdata);
         UnrefAudio(track->input_audio);
         if (track->ioclamp.io) {  // if we applied an i/o clamp to the stream, close that unconditionally.
@@ -1715,6 +2374,7 @@ bool MIX_SetTrackAudioStream(MIX_Track *track, SDL_AudioStream *stream)
     LockTrack(track);
 
     if (track->input_audio) {
+        FreeTrackSnapshot(track);
         track->input_audio->decoder->quit_track(track->decoder_userdata);
         UnrefAudio(track->input_audio);
         track->input_audio = NULL;
@@ -2050,6 +2710,7 @@ bool MIX_SetTrackPlaybackPosition(MIX_Track *track, Sint64 frames)
     bool retval = true;
 
     // !!! FIXME: should it be legal to seek past the end of an track (so it just stops immediately, or maybe stops on next callback)?
+    LockMixer(track->mixer);  // seeking reports MIX_TRACE_SEEK, which reads the mixer's trace callback.
     LockTrack(track);
     if (!track->input_audio) {
         if (track->input_stream) {  // can't seek a stream that was set up with MIX_SetTrackAudioStream.
@@ -2058,13 +2719,14 @@ bool MIX_SetTrackPlaybackPosition(MIX_Track *track, Sint64 frames)
             retval = SDL_SetError("No audio currently assigned to this track");
         }
     } else {
-        retval = track->input_audio->decoder->seek(track->decoder_userdata, (Uint64) frames);
+        retval = SeekTrackDecoder(track, (Uint64) frames);
         if (retval) {
             SDL_ClearAudioStream(track->input_stream);   // make sure that any extra buffered input from before the seek is removed.
             track->position = (Uint64) frames;
         }
     }
     UnlockTrack(track);
+    UnlockMixer(track->mixer);
 
     return retval;
 }
@@ -2272,6 +2934,7 @@ bool MIX_PlayTrack(MIX_Track *track, SDL_PropertiesID options)
     float fade_start_gain = 0.0f;
     bool halt_when_exhausted = true;
 
+    LockMixer(track->mixer);  // seeking reports MIX_TRACE_SEEK, which reads the mixer's trace callback.
     LockTrack(track);
     if (options) {
         loops = (int) SDL_GetNumberProperty(options, MIX_PROP_PLAY_LOOPS_NUMBER, loops);
@@ -2303,14 +2966,21 @@ bool MIX_PlayTrack(MIX_Track *track, SDL_PropertiesID options)
         start_order = -1;  // ignore this option, it doesn't mean anything on this decoder.
     }
 
+    if ((start_order < 0) && (loops != 0) && track->input_audio) {
+        PrepareTrackSnapshot(track, (Uint64) loop_start);  // this might move the decoder, but we're about to seek it to start_pos anyway.
+    }
+
     if ((start_order >= 0) && !track->input_audio->decoder->jump_to_order(track->decoder_userdata, start_order)) {
         UnlockTrack(track);
+        UnlockMixer(track->mixer);
         return false;
-    } else if (track->input_audio && (!track->input_audio->decoder->seek(track->decoder_userdata, start_pos))) {
+    } else if (track->input_audio && (!SeekTrackDecoder(track, (Uint64) start_pos))) {
         UnlockTrack(track);
+        UnlockMixer(track->mixer);
         return false;
     } else if (!track->input_audio && (start_pos != 0)) {
         UnlockTrack(track);
+        UnlockMixer(track->mixer);
         return SDL_SetError("Playing an input stream (not MIX_Audio) with a non-zero start position");  // !!! FIXME: should we just read off this many frames right now instead?
     }
 
@@ -2327,6 +2997,7 @@ bool MIX_PlayTrack(MIX_Track *track, SDL_PropertiesID options)
     track->halt_when_exhausted = halt_when_exhausted;
 
     UnlockTrack(track);
+    UnlockMixer(track->mixer);
     return true;
 }
 
@@ -2900,6 +3571,23 @@ bool MIX_SetPostMixCallback(MIX_Mixer *mixer, MIX_PostMixCallback cb, void *user
     return true;
 }
 
+bool MIX_SetMixerTraceCallback(MIX_Mixer *mixer, MIX_TraceCallback cb, void *userdata)
+{
+    if (!CheckMixerParam(mixer)) {
+        return false;
+    }
+
+#ifdef SDL_MIXER_TRACING
+    LockMixer(mixer);
+    mixer->trace_callback = cb;
+    mixer->trace_callback_userdata = userdata;
+    UnlockMixer(mixer);
+    return true;
+#else
+    return SDL_Unsupported();
+#endif
+}
+
 bool MIX_SetTrackRawCallback(MIX_Track *track, MIX_TrackMixCallback cb, void *userdata)
 {
     if (!CheckTrackParam(track)) {
@@ -3242,6 +3930,7 @@ static size_t MIX_IoClamp_read(void *userdata, void *ptr, size_t size, SDL_IOSta
         *status = (ret == remaining) ? SDL_IO_STATUS_EOF : SDL_GetIOStatus(clamp->io);
     }
     clamp->pos += ret;
+    clamp->bytes_read += ret;
     return ret;
 }
 
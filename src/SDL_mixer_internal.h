@@ -47,6 +47,10 @@
 #define MIX_HasSSE 1
 #endif
 
+#if defined(SDL_SSE2_INTRINSICS)  /* ...but not SSE2, which some 32-bit x86 chips lack. */
+extern bool MIX_HasSSE2;
+#endif
+
 #if defined(SDL_NEON_INTRINSICS)
 #if SDL_MIXER_NEED_SCALAR_FALLBACK
 extern bool MIX_HasNEON;
@@ -92,6 +96,7 @@ typedef struct MIX_IoClamp
     Sint64 start;
     Sint64 length;
     Sint64 pos;
+    Sint64 bytes_read;  // total read through this clamp, for load profiling.
 } MIX_IoClamp;
 
 extern SDL_IOStream *MIX_OpenIoClamp(MIX_IoClamp *clamp, SDL_IOStream *io);
@@ -106,6 +111,9 @@ typedef struct MIX_Decoder
     bool (SDLCALL *decode)(void *track_userdata, SDL_AudioStream *stream);
     bool (SDLCALL *seek)(void *track_userdata, Uint64 frame);
     bool (SDLCALL *jump_to_order)(void *track_userdata, int order);
+    void *(SDLCALL *snapshot)(void *track_userdata);  // optional: save complete decoder state, for a restore much cheaper than seeking. NULL on failure.
+    bool (SDLCALL *restore)(void *track_userdata, const void *snapshot);  // put back state from this track's snapshot().
+    void (SDLCALL *free_snapshot)(void *snapshot);
     void (SDLCALL *quit_track)(void *track_userdata);
     void (SDLCALL *quit_audio)(void *audio_userdata);
     void (SDLCALL *quit)(void);   // deinitialize the decoder (unload external libraries, etc).
@@ -135,6 +143,17 @@ struct MIX_Audio
     MIX_Audio *next;
 };
 
+// Per-track performance counters, updated by the mixing thread. Times are in SDL_GetPerformanceCounter() ticks, and converted when queried.
+typedef struct MIX_TrackCounters
+{
+    Uint64 decode_ticks;
+    Uint64 convert_ticks;
+    Uint64 callback_ticks;
+    Uint64 mix_ticks;
+    Uint64 decoded_bytes;
+    Uint64 mixed_frames;
+} MIX_TrackCounters;
+
 struct MIX_Track
 {
     float position3d[4];   // we only need the X, Y, and Z coords, but the 4th element makes this SIMD-friendly.
@@ -168,6 +187,8 @@ struct MIX_Track
     float fade_start_gain;  // between 0.0f and 1.0f. Fade with this volume as the starting point (fade-in only).
     int loops_remaining;  // seek to loop_start and continue this many more times at end of input. Negative to loop forever.
     int loop_start;      // sample frame position for loops to begin, so you can play an intro once and then loop from an internal point thereafter.
+    void *snapshot;      // decoder state at snapshot_frame, if the decoder supports snapshots. NULL otherwise.
+    Uint64 snapshot_frame;
     SDL_PropertiesID tags;  // lookup tags to see if they are currently applied to this track (true or false).
     MIX_TrackMixCallback raw_callback;
     void *raw_callback_userdata;
@@ -176,6 +197,7 @@ struct MIX_Track
     MIX_TrackStoppedCallback stopped_callback;
     void *stopped_callback_userdata;
     MIX_Group *group; // might be default_group, which should not be returned to the app (the app sees that as a NULL group).
+    MIX_TrackCounters counters;
     MIX_Track *prev;  // double-linked list for all_tracks.
     MIX_Track *next;
     MIX_Track *group_prev;  // double-linked list for the owning group.
@@ -194,6 +216,29 @@ struct MIX_Group
     MIX_Group *next;
 };
 
+// Performance counters, updated by the mixing thread. Times are in SDL_GetPerformanceCounter() ticks, and converted when queried.
+typedef struct MIX_MixerCounters
+{
+    Uint64 callbacks;
+    Uint64 last_callback_ticks;
+    Uint64 total_callback_ticks;
+    Uint64 max_callback_ticks;
+    Uint64 decode_ticks;
+    Uint64 convert_ticks;
+    Uint64 mix_ticks;
+    Uint64 group_callback_ticks;
+    Uint64 postmix_ticks;
+    Uint64 track_callback_ticks;  // time spent inside TrackGetCallback, so it can be subtracted out of conversion time.
+    Uint64 decoded_bytes;
+    Uint64 reallocs;
+    Uint64 underruns;
+    float last_load;
+    float max_load;
+    int playing_tracks;
+    int paused_tracks;
+    int stopped_tracks;
+} MIX_MixerCounters;
+
 struct MIX_Mixer
 {
     SDL_AudioStream *output_stream;
@@ -212,10 +257,32 @@ struct MIX_Mixer
     int actual_mixed_bytes;   // on each iteration of the mixer, number of bytes of real mixed audio, ignoring silence at end if no audio was available to mix there.
     float gain;
     MIX_VBAP2D vbap2d;
+    MIX_MixerCounters counters;
+#ifdef SDL_MIXER_TRACING
+    MIX_TraceCallback trace_callback;
+    void *trace_callback_userdata;
+#endif
     MIX_Mixer *prev;  // double-linked list for all_mixers.
     MIX_Mixer *next;
 };
 
+// MIX_RenderAudio mixes this many sample frames at a time.
+#define MIX_RENDER_BLOCK_FRAMES 16384
+
+// Tracing hooks compile to nothing unless SDL_MIXER_TRACING is defined. The app never sees the default group, so it's reported as NULL.
+#ifdef SDL_MIXER_TRACING
+#define MIX_TRACE(mixer, event, begin, track, group) do { \
+    MIX_Mixer *trace_mixer_ = (mixer); \
+    const MIX_TraceCallback trace_callback_ = trace_mixer_->trace_callback; \
+    if (trace_callback_) { \
+        MIX_Group *trace_group_ = (group); \
+        trace_callback_(trace_mixer_->trace_callback_userdata, trace_mixer_, event, begin, SDL_GetTicksNS(), track, (trace_group_ == trace_mixer_->default_group) ? NULL : trace_group_); \
+    } \
+} while (0)
+#else
+#define MIX_TRACE(mixer, event, begin, track, group)
+#endif
+
 // these are not (currently) available in the public API, and may change names or functionality, or be removed.
 #define MIX_PROP_DECODER_NAME_STRING "SDL_mixer.decoder.name"
 #define MIX_PROP_DECODER_FORMAT_NUMBER "SDL_mixer.decoder.format"
@@ -229,6 +296,8 @@ struct MIX_Mixer
 #define MIX_PROP_DECODER_FLUIDSYNTH_SOUNDFONT_IOSTREAM_POINTER "SDL_mixer.decoder.fluidsynth.soundfont_iostream"
 #define MIX_PROP_DECODER_FLUIDSYNTH_SOUNDFONT_PATH_STRING "SDL_mixer.decoder.fluidsynth.soundfont_path"
 #define MIX_PROP_DECODER_FLUIDSYNTH_PROPS_NUMBER "SDL_mixer.decoder.fluidsynth.props"
+#define MIX_PROP_DECODER_TIMIDITY_FRAMES_PER_DECODE_NUMBER "SDL_mixer.decoder.timidity.frames_per_decode"
+#define MIX_PROP_DECODER_TIMIDITY_THREADS_NUMBER "SDL_mixer.decoder.timidity.threads"
 #define MIX_PROP_AUDIO_LOAD_PATH_STRING "SDL_mixer.audio.load.path"
 #define MIX_PROP_AUDIO_LOAD_ONDEMAND_BOOLEAN "SDL_mixer.audio.load.ondemand"
 
@@ -277,6 +346,29 @@ void *MIX_GetConstIOBuffer(SDL_IOStream *io, size_t *datalen);
 // Slurp in all the data from an SDL_IOStream; if it appears to be memory-based, return the pointer with no allocation or copy made.
 void *MIX_SlurpConstIO(SDL_IOStream *io, size_t *datalen, bool *copied);
 
+// Standard MIDI File timing, for MIDI decoders to get duration and seek targets without loading instruments.
+typedef struct MIX_MIDITempoChange
+{
+    Uint32 tick;   // MIDI tick where this tempo takes effect.
+    Uint32 tempo;  // microseconds per quarter note.
+    Uint64 usec;   // song time at `tick`, in microseconds.
+} MIX_MIDITempoChange;
+
+typedef struct MIX_MIDITempoMap
+{
+    MIX_MIDITempoChange *changes;  // sorted by tick, changes[0] is always at tick 0.
+    int num_changes;
+    Uint32 division;  // ticks per quarter note (ticks per second for SMPTE timing).
+    Uint32 total_ticks;  // tick of the last End of Track event.
+    bool smpte;
+} MIX_MIDITempoMap;
+
+bool MIX_ParseMIDITempoMap(const Uint8 *data, size_t datalen, MIX_MIDITempoMap *tempomap);
+void MIX_FreeMIDITempoMap(MIX_MIDITempoMap *tempomap);
+Uint64 MIX_MIDITicksToMicroseconds(const MIX_MIDITempoMap *tempomap, Uint32 tick);
+Uint32 MIX_MIDIMicrosecondsToTicks(const MIX_MIDITempoMap *tempomap, Uint64 usec);
+Sint64 MIX_GetMIDIDurationFrames(const MIX_MIDITempoMap *tempomap, int freq);
+
 
 // mu-Law and a-Law lookup tables.
 extern const float MIX_alawToFloat[256];
@@ -0,0 +1,247 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2026 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+// A minimal Standard MIDI File scanner, shared by the MIDI decoders. It walks the event stream once
+//  to find tempo changes and where the song ends, without touching notes or loading any instruments.
+
+#include "SDL_mixer_internal.h"
+
+#if defined(DECODER_MIDI_TIMIDITY) || defined(DECODER_MIDI_FLUIDSYNTH)
+
+#define MIDI_DEFAULT_TEMPO 500000  // microseconds per quarter note (120bpm).
+
+static Uint32 ReadBE32(const Uint8 *ptr)
+{
+    return (((Uint32) ptr[0]) << 24) | (((Uint32) ptr[1]) << 16) | (((Uint32) ptr[2]) << 8) | ((Uint32) ptr[3]);
+}
+
+static Uint16 ReadBE16(const Uint8 *ptr)
+{
+    return (Uint16) ((((Uint32) ptr[0]) << 8) | ((Uint32) ptr[1]));
+}
+
+static Uint32 ReadVarLen(const Uint8 **ptr, const Uint8 *end)
+{
+    Uint32 val = 0;
+    for (int i = 0; (i < 4) && (*ptr < end); i++) {
+        const Uint8 byte = *((*ptr)++);
+        val = (val << 7) | (byte & 0x7F);
+        if ((byte & 0x80) == 0) {
+            break;
+        }
+    }
+    return val;
+}
+
+static int SDLCALL CompareTempoChanges(const void *a, const void *b)
+{
+    // SDL_qsort is not stable, so same-tick changes fall back to file order and the later one wins.
+    const MIX_MIDITempoChange *changea = (const MIX_MIDITempoChange *) a;
+    const MIX_MIDITempoChange *changeb = (const MIX_MIDITempoChange *) b;
+    if (changea->tick != changeb->tick) {
+        return (changea->tick < changeb->tick) ? -1 : 1;
+    }
+    return (changea->usec < changeb->usec) ? -1 : (changea->usec > changeb->usec) ? 1 : 0;
+}
+
+bool MIX_ParseMIDITempoMap(const Uint8 *data, size_t datalen, MIX_MIDITempoMap *tempomap)
+{
+    SDL_zerop(tempomap);
+
+    const Uint8 *end = data + datalen;
+    if ((datalen < 14) || (SDL_memcmp(data, "MThd", 4) != 0)) {
+        return SDL_SetError("Not a MIDI audio stream");
+    }
+
+    const Uint32 hdrlen = ReadBE32(data + 4);
+    const Uint16 ntracks = ReadBE16(data + 10);
+    const Uint16 division = ReadBE16(data + 12);
+    if ((hdrlen < 6) || (hdrlen > (datalen - 8))) {
+        return SDL_SetError("Corrupt MIDI header");
+    }
+
+    // SMPTE timing counts ticks per second directly, so treat it as one fixed "quarter note" per second and ignore tempo events.
+    //  (29 means 29.97 drop-frame, which is close enough to 30 for our purposes.)
+    bool smpte = false;
+    Uint32 ticks_per_quarter = division;
+    if (division & 0x8000) {
+        int fps = -((int) (Sint8) (division >> 8));
+        if (fps == 29) {
+            fps = 30;
+        }
+        ticks_per_quarter = ((Uint32) fps) * (division & 0xFF);
+        smpte = true;
+    }
+
+    if (ticks_per_quarter == 0) {
+        return SDL_SetError("Corrupt MIDI header");
+    }
+
+    MIX_MIDITempoChange *changes = NULL;
+    int num_changes = 0;
+    int allocated = 0;
+    Uint32 total_ticks = 0;
+
+    const Uint8 *ptr = data + 8 + hdrlen;
+    for (int track = 0; (track < (int) ntracks) && ((size_t) (end - ptr) >= 8); track++) {
+        const Uint32 chunklen = ReadBE32(ptr + 4);
+        const bool is_track = (SDL_memcmp(ptr, "MTrk", 4) == 0);
+        ptr += 8;
+        const Uint8 *chunkend = ((size_t) (end - ptr) < chunklen) ? end : (ptr + chunklen);
+        if (!is_track) {
+            track--;  // unknown chunks don't count as a track.
+            ptr = chunkend;
+            continue;
+        }
+
+        // truncated or corrupt tracks just end early, like the players treat them.
+        Uint32 tick = 0;
+        Uint8 status = 0;
+        while (ptr < chunkend) {
+            tick += ReadVarLen(&ptr, chunkend);
+            if (ptr >= chunkend) {
+                break;
+            }
+
+            if (*ptr & 0x80) {
+                status = *(ptr++);
+            } else if (status == 0) {
+                break;  // running status with nothing to run on.
+            }
+
+            if (status == 0xFF) {  // meta event.
+                if (ptr >= chunkend) {
+                    break;
+                }
+                const Uint8 type = *(ptr++);
+                const Uint32 len = ReadVarLen(&ptr, chunkend);
+                if ((size_t) (chunkend - ptr) < len) {
+                    break;
+                } else if ((type == 0x51) && (len == 3) && !smpte) {  // Set Tempo
+                    if (num_changes >= allocated) {
+                        allocated = allocated ? (allocated * 2) : 16;
+                        void *ptr2 = SDL_realloc(changes, allocated * sizeof (*changes));
+                        if (!ptr2) {
+                            SDL_free(changes);
+                            return false;
+                        }
+                        changes = (MIX_MIDITempoChange *) ptr2;
+                    }
+                    changes[num_changes].tick = tick;
+                    changes[num_changes].tempo = (((Uint32) ptr[0]) << 16) | (((Uint32) ptr[1]) << 8) | ((Uint32) ptr[2]);
+                    changes[num_changes].usec = (Uint64) num_changes;  // sort key until the final pass fills in real times.
+                    num_changes++;
+                } else if (type == 0x2F) {  // End of Track
+                    break;
+                }
+                ptr += len;
+                status = 0;  // meta and sysex events cancel running status.
+            } else if ((status == 0xF0) || (status == 0xF7)) {  // sysex.
+                const Uint32 len = ReadVarLen(&ptr, chunkend);
+                if ((size_t) (chunkend - ptr) < len) {
+                    break;
+                }
+                ptr += len;
+                status = 0;
+            } else {
+                const Uint8 cmd = status & 0xF0;
+                const size_t len = ((cmd == 0xC0) || (cmd == 0xD0)) ? 1 : 2;
+                if ((size_t) (chunkend - ptr) < len) {
+                    break;
+                }
+                ptr += len;
+            }
+        }
+
+        total_ticks = SDL_max(total_ticks, tick);
+        ptr = chunkend;
+    }
+
+    if (num_changes > 1) {
+        SDL_qsort(changes, num_changes, sizeof (*changes), CompareTempoChanges);
+    }
+
+    // the final map always starts with the default tempo at tick 0, then accumulates time at each change.
+    MIX_MIDITempoChange *final_changes = (MIX_MIDITempoChange *) SDL_malloc((num_changes + 1) * sizeof (*final_changes));
+    if (!final_changes) {
+        SDL_free(changes);
+        return false;
+    }
+
+    final_changes[0].tick = 0;
+    final_changes[0].tempo = smpte ? 1000000 : MIDI_DEFAULT_TEMPO;
+    final_changes[0].usec = 0;
+    int num_final = 1;
+    for (int i = 0; i < num_changes; i++) {
+        const MIX_MIDITempoChange *prev = &final_changes[num_final - 1];
+        const Uint64 usec = prev->usec + ((((Uint64) (changes[i].tick - prev->tick)) * prev->tempo) / ticks_per_quarter);
+        if (changes[i].tick == prev->tick) {
+            num_final--;  // replace a change at the same tick.
+        }
+        final_changes[num_final].tick = changes[i].tick;
+        final_changes[num_final].tempo = changes[i].tempo ? changes[i].tempo : 1;
+        final_changes[num_final].usec = usec;
+        num_final++;
+    }
+    SDL_free(changes);
+
+    tempomap->changes = final_changes;
+    tempomap->num_changes = num_final;
+    tempomap->division = ticks_per_quarter;
+    tempomap->total_ticks = total_ticks;
+    tempomap->smpte = smpte;
+    return true;
+}
+
+void MIX_FreeMIDITempoMap(MIX_MIDITempoMap *tempomap)
+{
+    if (tempomap) {
+        SDL_free(tempomap->changes);
+        SDL_zerop(tempomap);
+    }
+}
+
+Uint64 MIX_MIDITicksToMicroseconds(const MIX_MIDITempoMap *tempomap, Uint32 tick)
+{
+    const MIX_MIDITempoChange *change = tempomap->changes;
+    for (int i = 1; (i < tempomap->num_changes) && (tempomap->changes[i].tick <= tick); i++) {
+        change = &tempomap->changes[i];
+    }
+    return change->usec + ((((Uint64) (tick - change->tick)) * change->tempo) / tempomap->division);
+}
+
+Uint32 MIX_MIDIMicrosecondsToTicks(const MIX_MIDITempoMap *tempomap, Uint64 usec)
+{
+    const MIX_MIDITempoChange *change = tempomap->changes;
+    for (int i = 1; (i < tempomap->num_changes) && (tempomap->changes[i].usec <= usec); i++) {
+        change = &tempomap->changes[i];
+    }
+    const Uint64 ticks = change->tick + (((usec - change->usec) * tempomap->division) / change->tempo);
+    return (Uint32) SDL_min(ticks, (Uint64) SDL_MAX_SINT32);
+}
+
+Sint64 MIX_GetMIDIDurationFrames(const MIX_MIDITempoMap *tempomap, int freq)
+{
+    const Uint64 usec = MIX_MIDITicksToMicroseconds(tempomap, tempomap->total_ticks);
+    return (Sint64) (((usec / 1000000) * freq) + (((usec % 1000000) * freq) / 1000000));
+}
+
+#endif
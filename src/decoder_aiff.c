@@ -582,6 +582,9 @@ const MIX_Decoder MIX_Decoder_AIFF = {
     AIFF_decode,
     AIFF_seek,
     NULL,  // jump_to_order
+    NULL,  // snapshot
+    NULL,  // restore
+    NULL,  // free_snapshot
     AIFF_quit_track,
     AIFF_quit_audio,
     NULL  // quit
@@ -270,6 +270,9 @@ const MIX_Decoder MIX_Decoder_AU = {
     AU_decode,
     AU_seek,
     NULL,  // jump_to_order
+    NULL,  // snapshot
+    NULL,  // restore
+    NULL,  // free_snapshot
     AU_quit_track,
     AU_quit_audio,
     NULL  // quit
@@ -333,6 +333,9 @@ const MIX_Decoder MIX_Decoder_DRFLAC = {
     DRFLAC_decode,
     DRFLAC_seek,
     NULL,  // jump_to_order
+    NULL,  // snapshot
+    NULL,  // restore
+    NULL,  // free_snapshot
     DRFLAC_quit_track,
     DRFLAC_quit_audio,
     NULL  // quit
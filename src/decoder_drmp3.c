@@ -42,7 +42,10 @@
 #define DRMP3_REALLOC(p, sz) SDL_realloc((p), (sz))
 #define DRMP3_FREE(p) SDL_free((p))
 
-// !!! FIXME: we need a DRMP3_NO_PARSE_METADATA_TAGS option to remove the ID3/APE checks, since we filtered them elsewhere.
+// Normally MIX_ReadMetadataTags has already clamped ID3/APE tags off both ends of the stream, so don't make dr_mp3 look
+//  for them again. With MIX_PROP_AUDIO_LOAD_SKIP_METADATA_TAGS_BOOLEAN, nothing skips them, so those callers must supply
+//  MP3 data that has no tags.
+#define DRMP3_NO_PARSE_METADATA_TAGS
 
 #include "dr_libs/dr_mp3.h"
 
@@ -80,6 +83,92 @@ static drmp3_bool32 DRMP3_IoTell(void *context, drmp3_int64 *pos)
 }
 
 
+// This walks the whole file once, counting frames and building a seek table as it goes. It's equivalent to
+//  drmp3_get_mp3_and_pcm_frame_count() followed by drmp3_calculate_seek_points(), but each of those scans the
+//  entire file (and the seek point calculation calls the frame count function internally, too!), so doing it
+//  ourselves saves us from decoding every frame header three times at load time.
+// This places a seek point at the start of every MP3 frame (after the leading frames needed to prime the bit
+//  reservoir), which is the same density we used to ask drmp3_calculate_seek_points() for.
+// If this fails to allocate the seek table, we go on without one; the frame count is still valid.
+static bool DRMP3_ScanStream(drmp3 *decoder, DRMP3_AudioData *adata, drmp3_uint64 *num_pcm_frames)
+{
+    typedef struct { drmp3_uint64 byte_pos; drmp3_uint64 pcm_frame; } MP3FrameInfo;
+    MP3FrameInfo frameinfo[DRMP3_SEEK_LEADING_MP3_FRAMES + 1];
+    drmp3_uint64 running_pcm_frames = 0;
+    float running_pcm_frames_fraction = 0.0f;
+    drmp3_uint64 total_pcm_frames = 0;
+    drmp3_uint64 total_mp3_frames = 0;
+    drmp3_uint32 allocated_seek_points = 0;
+    bool seek_table_okay = true;
+
+    if (!drmp3_seek_to_start_of_stream(decoder)) {
+        return false;
+    }
+
+    while (true) {
+        // The byte position of the next frame is the stream's cursor position, minus whatever is sitting in the buffer.
+        SDL_assert(decoder->streamCursor >= decoder->dataSize);
+        const drmp3_uint64 byte_pos = decoder->streamCursor - decoder->dataSize;
+        const drmp3_uint64 pcm_frame = running_pcm_frames;
+
+        const drmp3_uint32 pcm_frames_in_mp3_frame = drmp3_decode_next_frame_ex(decoder, NULL, NULL, NULL);
+        if (pcm_frames_in_mp3_frame == 0) {
+            break;  // end of stream (or garbage we can't sync past).
+        }
+
+        total_pcm_frames += pcm_frames_in_mp3_frame;
+        drmp3__accumulate_running_pcm_frame_count(decoder, pcm_frames_in_mp3_frame, &running_pcm_frames, &running_pcm_frames_fraction);
+
+        // cycle the cached frame info for the leading frames.
+        if (total_mp3_frames < SDL_arraysize(frameinfo)) {
+            frameinfo[total_mp3_frames].byte_pos = byte_pos;
+            frameinfo[total_mp3_frames].pcm_frame = pcm_frame;
+        } else {
+            SDL_memmove(&frameinfo[0], &frameinfo[1], sizeof (frameinfo) - sizeof (frameinfo[0]));
+            frameinfo[SDL_arraysize(frameinfo) - 1].byte_pos = byte_pos;
+            frameinfo[SDL_arraysize(frameinfo) - 1].pcm_frame = pcm_frame;
+        }
+
+        total_mp3_frames++;
+
+        if (seek_table_okay && (total_mp3_frames >= SDL_arraysize(frameinfo))) {
+            if (adata->num_seek_points >= allocated_seek_points) {
+                const drmp3_uint32 newlen = allocated_seek_points ? (allocated_seek_points * 2) : 1024;
+                void *ptr = (newlen > allocated_seek_points) ? SDL_realloc(adata->seek_points, newlen * sizeof (*adata->seek_points)) : NULL;
+                if (!ptr) {  // failed, oh well. Live without.
+                    SDL_free(adata->seek_points);
+                    adata->seek_points = NULL;
+                    adata->num_seek_points = 0;
+                    seek_table_okay = false;
+                } else {
+                    adata->seek_points = (drmp3_seek_point *) ptr;
+                    allocated_seek_points = newlen;
+                }
+            }
+
+            if (seek_table_okay) {
+                // Seeking here means: jump to the oldest cached frame, decode and discard the leading frames, then discard PCM frames up to the start of the newest one.
+                drmp3_seek_point *seekpoint = &adata->seek_points[adata->num_seek_points++];
+                seekpoint->seekPosInBytes = frameinfo[0].byte_pos;
+                seekpoint->pcmFrameIndex = frameinfo[DRMP3_SEEK_LEADING_MP3_FRAMES].pcm_frame;
+                seekpoint->mp3FramesToDiscard = DRMP3_SEEK_LEADING_MP3_FRAMES;
+                seekpoint->pcmFramesToDiscard = (drmp3_uint16) (frameinfo[DRMP3_SEEK_LEADING_MP3_FRAMES].pcm_frame - frameinfo[DRMP3_SEEK_LEADING_MP3_FRAMES - 1].pcm_frame);
+            }
+        }
+    }
+
+    // shrink the array if possible.
+    if (adata->seek_points && (adata->num_seek_points < allocated_seek_points)) {
+        void *ptr = SDL_realloc(adata->seek_points, adata->num_seek_points * sizeof (*adata->seek_points));
+        if (ptr) {
+            adata->seek_points = (drmp3_seek_point *) ptr;
+        }
+    }
+
+    *num_pcm_frames = total_pcm_frames;
+    return true;
+}
+
 static bool SDLCALL DRMP3_init_audio(SDL_IOStream *io, SDL_AudioSpec *spec, SDL_PropertiesID props, Sint64 *duration_frames, void **audio_userdata)
 {
     drmp3 decoder;
@@ -94,29 +183,14 @@ static bool SDLCALL DRMP3_init_audio(SDL_IOStream *io, SDL_AudioSpec *spec, SDL_
         return false;
     }
 
-    // I don't know if this is a great idea, as this is allegedly inefficient, but let's precalculate a seek table at load time, so each track can reuse it.
+    // precalculate the frame count and a seek table at load time in a single pass, so each track can reuse it.
     // (If any of this fails, we go on without it.)
-    drmp3_uint64 num_mp3_frames = 0;
     drmp3_uint64 num_pcm_frames = 0;
-    if (drmp3_get_mp3_and_pcm_frame_count(&decoder, &num_mp3_frames, &num_pcm_frames)) {
-        adata->num_seek_points = (drmp3_uint32) num_mp3_frames;
-        adata->seek_points = (drmp3_seek_point *) SDL_calloc(num_mp3_frames, sizeof (*adata->seek_points));
-        if (adata->seek_points) {
-            if (drmp3_calculate_seek_points(&decoder, &adata->num_seek_points, adata->seek_points)) {
-                // shrink the array if possible.
-                if (adata->num_seek_points < ((drmp3_uint32) num_mp3_frames)) {
-                    void *ptr = SDL_realloc(adata->seek_points, adata->num_seek_points * sizeof (*adata->seek_points));
-                    if (ptr) {
-                        adata->seek_points = (drmp3_seek_point *) ptr;
-                    }
-                }
-            } else {  // failed, oh well. Live without.
-                SDL_free(adata->seek_points);
-                adata->seek_points = NULL;
-                adata->num_seek_points = 0;
-            }
-        }
+    const Uint64 scan_start = SDL_GetTicksNS();
+    if (!DRMP3_ScanStream(&decoder, adata, &num_pcm_frames)) {
+        num_pcm_frames = 0;
     }
+    SDL_SetNumberProperty(props, MIX_PROP_AUDIO_LOAD_PROFILE_SEEK_TABLE_NS_NUMBER, (Sint64) (SDL_GetTicksNS() - scan_start));
 
     spec->format = SDL_AUDIO_F32;
     spec->channels = (int) decoder.channels;
@@ -196,6 +270,9 @@ const MIX_Decoder MIX_Decoder_DRMP3 = {
     DRMP3_decode,
     DRMP3_seek,
     NULL,  // jump_to_order
+    NULL,  // snapshot
+    NULL,  // restore
+    NULL,  // free_snapshot
     DRMP3_quit_track,
     DRMP3_quit_audio,
     NULL  // quit
@@ -71,8 +71,8 @@ typedef struct FLAC_TrackData
     SDL_AudioStream *stream;
     SDL_AudioSpec spec;
     int bits_per_sample;
-    Uint8 *cvtbuf;
-    size_t cvtbuflen;
+    float *cvtbuf;
+    size_t cvtbuflen;  // in bytes.
     Sint64 current_iteration;
     Sint64 current_iteration_frames;
 } FLAC_TrackData;
@@ -130,6 +130,105 @@ static FLAC__bool FLAC_IoEOF(const FLAC__StreamDecoder *decoder, void *userdata)
     return SDL_TellIO(tdata->io) >= SDL_GetIOSize(tdata->io);
 }
 
+// libFLAC hands us planar Sint32 samples of `bits_per_sample` significant bits. Rather than shifting them up to a full SDL
+//  format in one pass, and then having SDL_PutAudioStreamPlanarData interleave them and SDL_AudioStream convert them to
+//  float in two more, we go straight to interleaved float here, which is what the mixer wants anyhow.
+// Multiplying by a power of two is exact, so all of these produce the same bits as SDL's S32->F32 conversion of the shifted data.
+
+#ifdef SDL_SSE2_INTRINSICS
+static void SDL_TARGETING("sse2") FLAC_ConvertStereoToFloat_SSE2(float *dst, const FLAC__int32 *left, const FLAC__int32 *right, size_t frames, float scale)
+{
+    const __m128 vscale = _mm_set1_ps(scale);
+    size_t i = 0;
+    for (; (i + 4) <= frames; i += 4) {
+        const __m128 l = _mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i *) &left[i])), vscale);
+        const __m128 r = _mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i *) &right[i])), vscale);
+        _mm_storeu_ps(dst, _mm_unpacklo_ps(l, r));
+        _mm_storeu_ps(dst + 4, _mm_unpackhi_ps(l, r));
+        dst += 8;
+    }
+    for (; i < frames; i++) {
+        *(dst++) = ((float) left[i]) * scale;
+        *(dst++) = ((float) right[i]) * scale;
+    }
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+static void FLAC_ConvertStereoToFloat_NEON(float *dst, const FLAC__int32 *left, const FLAC__int32 *right, size_t frames, float scale)
+{
+    size_t i = 0;
+    for (; (i + 4) <= frames; i += 4) {
+        float32x4x2_t lr;
+        lr.val[0] = vmulq_n_f32(vcvtq_f32_s32(vld1q_s32((const int32_t *) &left[i])), scale);
+        lr.val[1] = vmulq_n_f32(vcvtq_f32_s32(vld1q_s32((const int32_t *) &right[i])), scale);
+        vst2q_f32(dst, lr);  // interleaves as it stores.
+        dst += 8;
+    }
+    for (; i < frames; i++) {
+        *(dst++) = ((float) left[i]) * scale;
+        *(dst++) = ((float) right[i]) * scale;
+    }
+}
+#endif
+
+static void FLAC_ConvertStereoToFloat(float *dst, const FLAC__int32 *left, const FLAC__int32 *right, size_t frames, float scale)
+{
+    #if defined(SDL_SSE2_INTRINSICS)
+    if (MIX_HasSSE2) {
+        FLAC_ConvertStereoToFloat_SSE2(dst, left, right, frames, scale);
+        return;
+    }
+    #elif defined(SDL_NEON_INTRINSICS)
+    if (MIX_HasNEON) {
+        FLAC_ConvertStereoToFloat_NEON(dst, left, right, frames, scale);
+        return;
+    }
+    #endif
+
+    for (size_t i = 0; i < frames; i++) {
+        *(dst++) = ((float) left[i]) * scale;
+        *(dst++) = ((float) right[i]) * scale;
+    }
+}
+
+// `dstchannels` may be larger than `channels`; the extra channels are filled with silence.
+static void FLAC_ConvertToFloat(float *dst, const FLAC__int32 *const buffer[], int channels, int dstchannels, size_t frames, int bits_per_sample)
+{
+    const float scale = 1.0f / ((float) (((Uint32) 1) << (bits_per_sample - 1)));
+
+    if ((channels == 2) && (dstchannels == 2)) {  // the overwhelmingly common case: 16 or 24-bit stereo.
+        FLAC_ConvertStereoToFloat(dst, buffer[0], buffer[1], frames, scale);
+    } else if ((channels == 1) && (dstchannels == 1)) {
+        const FLAC__int32 *src = buffer[0];
+        for (size_t i = 0; i < frames; i++) {
+            dst[i] = ((float) src[i]) * scale;
+        }
+    } else if ((channels == 3) && (dstchannels == 6)) {
+        // FLAC 3-channel is FL, FR, FC, but SDL doesn't have a front center channel until 5.1, so pad it out: FL, FR, FC, LFE, BL, BR.
+        const FLAC__int32 *fl = buffer[0];
+        const FLAC__int32 *fr = buffer[1];
+        const FLAC__int32 *fc = buffer[2];
+        for (size_t i = 0; i < frames; i++) {
+            dst[0] = ((float) fl[i]) * scale;
+            dst[1] = ((float) fr[i]) * scale;
+            dst[2] = ((float) fc[i]) * scale;
+            dst[3] = dst[4] = dst[5] = 0.0f;
+            dst += 6;
+        }
+    } else {
+        for (size_t i = 0; i < frames; i++) {
+            int channel;
+            for (channel = 0; channel < channels; channel++) {
+                *(dst++) = ((float) buffer[channel][i]) * scale;
+            }
+            for (; channel < dstchannels; channel++) {
+                *(dst++) = 0.0f;
+            }
+        }
+    }
+}
+
 static FLAC__StreamDecoderWriteStatus FLAC_IoWriteNoOp(const FLAC__StreamDecoder *decoder, const FLAC__Frame *frame, const FLAC__int32 *const buffer[], void *userdata)
 {
     return FLAC__STREAM_DECODER_WRITE_STATUS_CONTINUE;  // we don't need this data at this moment.
@@ -151,26 +250,18 @@ static FLAC__StreamDecoderWriteStatus FLAC_IoWrite(const FLAC__StreamDecoder *de
         tdata->bits_per_sample = (int) frame->header.bits_per_sample;
         tdata->spec.freq = (int) frame->header.sample_rate;
         tdata->spec.channels = sdlchannels;
-        // decoded FLAC data is always int, from 4 to 32 bits, apparently.
-        if (tdata->bits_per_sample <= 8) {
-            tdata->spec.format = SDL_AUDIO_S8;
-        } else if (tdata->bits_per_sample <= 16) {
-            tdata->spec.format = SDL_AUDIO_S16;
-        } else if (tdata->bits_per_sample <= 32) {
-            tdata->spec.format = SDL_AUDIO_S32;
-        }
+        tdata->spec.format = SDL_AUDIO_F32;  // decoded FLAC data is always int, from 4 to 32 bits, apparently, but we convert it to float ourselves.
         SDL_SetAudioStreamFormat(stream, &tdata->spec, NULL);
     }
 
     size_t amount = (size_t) frame->header.blocksize;
-    const size_t onebuflen = ((size_t) SDL_AUDIO_BYTESIZE(tdata->spec.format)) * amount;
-    const size_t buflen = onebuflen * channels;
+    const size_t buflen = amount * sdlchannels * sizeof (float);
     if (tdata->cvtbuflen < buflen) {
         void *ptr = SDL_realloc(tdata->cvtbuf, buflen);
         if (!ptr) {
             return FLAC__STREAM_DECODER_WRITE_STATUS_ABORT;
         }
-        tdata->cvtbuf = (Uint8 *) ptr;
+        tdata->cvtbuf = (float *) ptr;
         tdata->cvtbuflen = buflen;
     }
 
@@ -217,37 +308,8 @@ static FLAC__StreamDecoderWriteStatus FLAC_IoWrite(const FLAC__StreamDecoder *de
     }
 
     if (amount > 0) {
-        void *channel_arrays[32];
-        SDL_assert(SDL_arraysize(channel_arrays) >= (size_t)channels);
-
-        // (If we padded out to 5.1 to get a front-center channel, the unnecessary channels happen
-        //   to be at the end, so it'll assume those padded channels are silent.)
-        for (int i = 0; i < channels; i++) {
-            channel_arrays[i] = tdata->cvtbuf + (i * onebuflen);
-        }
-
-        const int shift = SDL_AUDIO_BITSIZE(tdata->spec.format) - tdata->bits_per_sample;
-
-        #define PREP_CHANNEL_ARRAY(typ) { \
-            for (int channel = 0; channel < channels; channel++) { \
-                const Sint32 *src = (const Sint32 *) buffer[channel]; \
-                typ *dst = (typ *) channel_arrays[channel]; \
-                for (size_t i = 0; i < amount; i++) { \
-                    dst[i] = (typ) (src[i] << shift); \
-                } \
-            } \
-        }
-
-        switch (tdata->spec.format) {
-            case SDL_AUDIO_S8: PREP_CHANNEL_ARRAY(Sint8); break;
-            case SDL_AUDIO_S16: PREP_CHANNEL_ARRAY(Sint16); break;
-            case SDL_AUDIO_S32: PREP_CHANNEL_ARRAY(Sint32); break;
-            default: SDL_assert(!"Unexpected audio data type"); return FLAC__STREAM_DECODER_WRITE_STATUS_ABORT;
-        }
-
-        #undef PREP_CHANNEL_ARRAY
-
-        SDL_PutAudioStreamPlanarData(stream, (const void * const *) channel_arrays, channels, amount);
+        FLAC_ConvertToFloat(tdata->cvtbuf, buffer, channels, sdlchannels, amount, tdata->bits_per_sample);
+        SDL_PutAudioStreamData(stream, tdata->cvtbuf, (int) (amount * sdlchannels * sizeof (float)));
         tdata->current_iteration_frames += amount;
     }
 
@@ -263,15 +325,7 @@ static void FLAC_IoMetadata(const FLAC__StreamDecoder *decoder, const FLAC__Stre
         tdata->spec.freq = metadata->data.stream_info.sample_rate;
         tdata->spec.channels = metadata->data.stream_info.channels;   // (if we need the 3-channel map magic, it'll notice spec.channels is wrong when we get to FLAC_IoWrite and set it up.)
         tdata->bits_per_sample = (int) metadata->data.stream_info.bits_per_sample;
-
-        // decoded FLAC data is always int, from 4 to 32 bits, apparently.
-        if (tdata->bits_per_sample <= 8) {
-            tdata->spec.format = SDL_AUDIO_S8;
-        } else if (tdata->bits_per_sample <= 16) {
-            tdata->spec.format = SDL_AUDIO_S16;
-        } else if (tdata->bits_per_sample <= 32) {
-            tdata->spec.format = SDL_AUDIO_S32;
-        }
+        tdata->spec.format = SDL_AUDIO_F32;  // decoded FLAC data is always int, from 4 to 32 bits, apparently, but FLAC_IoWrite converts it to float.
     } else if (metadata->type == FLAC__METADATA_TYPE_VORBIS_COMMENT) {
         const FLAC__StreamMetadata_VorbisComment *vc = &metadata->data.vorbis_comment;
         const int num_comments = (int) vc->num_comments;
@@ -509,6 +563,9 @@ const MIX_Decoder MIX_Decoder_FLAC = {
     FLAC_decode,
     FLAC_seek,
     NULL,  // jump_to_order
+    NULL,  // snapshot
+    NULL,  // restore
+    NULL,  // free_snapshot
     FLAC_quit_track,
     FLAC_quit_audio,
     FLAC_quit
@@ -54,6 +54,8 @@ SDL_ELF_NOTE_DLOPEN(
     MIX_LOADER_FUNCTION(true,int,fluid_settings_getnum,(fluid_settings_t*, const char*, double*)) \
     MIX_LOADER_FUNCTION(true,int,fluid_sfloader_set_callbacks,(fluid_sfloader_t *,fluid_sfloader_callback_open_t,fluid_sfloader_callback_read_t,fluid_sfloader_callback_seek_t,fluid_sfloader_callback_tell_t,fluid_sfloader_callback_close_t)) \
     MIX_LOADER_FUNCTION(true,void,fluid_synth_add_sfloader,(fluid_synth_t *, fluid_sfloader_t *)) \
+    MIX_LOADER_FUNCTION(true,int,fluid_synth_add_sfont,(fluid_synth_t *, fluid_sfont_t *)) \
+    MIX_LOADER_FUNCTION(true,fluid_sfont_t *,fluid_synth_get_sfont_by_id,(fluid_synth_t *, int)) \
     MIX_LOADER_FUNCTION(true,int,fluid_synth_sfload,(fluid_synth_t*, const char*, int)) \
     MIX_LOADER_FUNCTION(true,int,fluid_synth_write_float,(fluid_synth_t*, int, void*, int, int, void*, int, int)) \
     MIX_LOADER_FUNCTION(true,fluid_sfloader_t *,new_fluid_defsfloader,(fluid_settings_t *settings)) \
@@ -66,23 +68,36 @@ SDL_ELF_NOTE_DLOPEN(
         MIX_LOADER_FUNCTIONS_fluidsynthbase \
         MIX_LOADER_FUNCTION(true,void,delete_fluid_player,(fluid_player_t*)) \
         MIX_LOADER_FUNCTION(true,void,delete_fluid_synth,(fluid_synth_t*)) \
+        MIX_LOADER_FUNCTION(true,int,fluid_synth_remove_sfont,(fluid_synth_t *, fluid_sfont_t *)) \
         MIX_LOADER_FUNCTION(true,int,fluid_player_seek,(fluid_player_t *, int))
 #else
     #define MIX_LOADER_FUNCTIONS \
         MIX_LOADER_FUNCTIONS_fluidsynthbase \
         MIX_LOADER_FUNCTION(true,int,delete_fluid_player,(fluid_player_t*)) \
-        MIX_LOADER_FUNCTION(true,int,delete_fluid_synth,(fluid_synth_t*))
+        MIX_LOADER_FUNCTION(true,int,delete_fluid_synth,(fluid_synth_t*)) \
+        MIX_LOADER_FUNCTION(true,void,fluid_synth_remove_sfont,(fluid_synth_t *, fluid_sfont_t *))
 #endif
 
 #define MIX_LOADER_MODULE fluidsynth
 #include "SDL_mixer_loader.h"
 
 
+// Seeking forward by less than this many seconds just renders through; anything else jumps the player.
+#define FLUIDSYNTH_RENDER_SEEK_SECONDS 1
+
+// The soundfont is parsed (and its samples decoded) once per MIX_Audio, into a private synth that owns it. Each
+//  track's synth just borrows that fluid_sfont_t, so a dozen tracks playing the same MIDI don't each hold their own
+//  copy of a 100 megabyte soundfont. Those tracks can render on different threads (several mixers, MIX_Generate,
+//  MIX_RenderAudio), and FluidSynth updates the shared soundfont's sample refcounts and id without any locking, so
+//  every synth holds sfont_lock while it renders, or adds, removes or deletes the borrowed soundfont.
 typedef struct FLUIDSYNTH_AudioData
 {
-    const Uint8 *sfdata;
-    size_t sfdatalen;
+    fluid_settings_t *sfont_settings;
+    fluid_synth_t *sfont_synth;
+    fluid_sfont_t *sfont;  // owned by sfont_synth. NULL if we have no soundfont.
+    SDL_Mutex *sfont_lock;  // NULL if we have no soundfont; locking a NULL mutex is a no-op.
     SDL_PropertiesID fluidsynth_props;
+    MIX_MIDITempoMap tempomap;  // changes==NULL if we couldn't build one; seeking falls back to rendering.
 } FLUIDSYNTH_AudioData;
 
 typedef struct FLUIDSYNTH_TrackData
@@ -90,6 +105,7 @@ typedef struct FLUIDSYNTH_TrackData
     const FLUIDSYNTH_AudioData *adata;
     fluid_synth_t *synth;
     fluid_settings_t *settings;
+    fluid_sfont_t *borrowed_sfont;  // adata->sfont, if we added it to our synth.
     fluid_player_t *player;
     Uint64 current_frame;
     int freq;
@@ -113,6 +129,125 @@ static void SDLCALL FLUIDSYNTH_quit(void)
     UnloadModule_fluidsynth();
 }
 
+// this is obnoxious, but you have to implement a whole loader to get a soundfont from memory.
+static void *SoundFontOpen(const char *filename)
+{
+    void *ptr = NULL;
+    if (SDL_sscanf(filename, "&FAKESFNAME&%p", &ptr) != 1) {
+        return NULL;
+    }
+    return ptr;  // (this is actually an SDL_IOStream pointer.)
+}
+
+static int SoundFontRead(void *buf, fluid_long_long_t count, void *handle)
+{
+    #if (SDL_SIZE_MAX < SDL_MAX_SINT64)
+    if (count > (fluid_long_long_t)(SDL_MAX_UINT32)) {
+        return FLUID_FAILED;
+    }
+    #endif
+    if (count < 0) {
+        return FLUID_FAILED;
+    }
+    return (SDL_ReadIO((SDL_IOStream *) handle, buf, count) == (size_t)count) ? FLUID_OK : FLUID_FAILED;
+}
+
+static int SoundFontSeek(void *handle, fluid_long_long_t offset, int origin)
+{
+    SDL_IOWhence whence;
+    switch (origin) {
+        case SEEK_SET: whence = SDL_IO_SEEK_SET; break;
+        case SEEK_CUR: whence = SDL_IO_SEEK_CUR; break;
+        case SEEK_END: whence = SDL_IO_SEEK_END; break;
+        default: return FLUID_FAILED;
+    }
+    return (SDL_SeekIO((SDL_IOStream *) handle, offset, whence) >= 0) ? FLUID_OK : FLUID_FAILED;
+}
+
+static int SoundFontClose(void *handle)
+{
+    SDL_CloseIO((SDL_IOStream *) handle);
+    return FLUID_OK;
+}
+
+static fluid_long_long_t SoundFontTell(void *handle)
+{
+    return SDL_TellIO((SDL_IOStream *) handle);
+}
+
+static void SDLCALL SetCustomFluidsynthProperties(void *userdata, SDL_PropertiesID props, const char *name)
+{
+    fluid_settings_t *settings = (fluid_settings_t *) userdata;
+    switch (SDL_GetPropertyType(props, name)) {
+        case SDL_PROPERTY_TYPE_NUMBER:
+            fluidsynth.fluid_settings_setint(settings, name, (int) SDL_GetNumberProperty(props, name, 0));
+            break;
+        case SDL_PROPERTY_TYPE_FLOAT:
+            fluidsynth.fluid_settings_setnum(settings, name, (double) SDL_GetFloatProperty(props, name, 0.0f));
+            break;
+        case SDL_PROPERTY_TYPE_STRING:
+            fluidsynth.fluid_settings_setstr(settings, name, SDL_GetStringProperty(props, name, ""));
+            break;
+        default: break;  // oh well.
+    }
+}
+
+static bool LoadSharedSoundFont(FLUIDSYNTH_AudioData *adata, const Uint8 *sfdata, size_t sfdatalen)
+{
+    adata->sfont_lock = SDL_CreateMutex();
+    if (!adata->sfont_lock) {
+        return false;
+    }
+
+    adata->sfont_settings = fluidsynth.new_fluid_settings();
+    if (!adata->sfont_settings) {
+        return SDL_SetError("Failed to create FluidSynth settings");
+    }
+
+    // custom properties might change how soundfonts load, so this synth gets them too. It never renders anything.
+    SDL_EnumerateProperties(adata->fluidsynth_props, SetCustomFluidsynthProperties, adata->sfont_settings);
+
+    adata->sfont_synth = fluidsynth.new_fluid_synth(adata->sfont_settings);
+    if (!adata->sfont_synth) {
+        return SDL_SetError("Failed to create FluidSynth synthesizer");
+    }
+
+    fluid_sfloader_t *sfloader = fluidsynth.new_fluid_defsfloader(adata->sfont_settings);
+    if (!sfloader) {
+        return SDL_SetError("Failed to create FluidSynth sfloader");
+    }
+
+    char fakefname[64];
+    SDL_snprintf(fakefname, sizeof (fakefname), "&FAKESFNAME&%p", SDL_IOFromConstMem(sfdata, sfdatalen));
+    fluidsynth.fluid_sfloader_set_callbacks(sfloader, SoundFontOpen, SoundFontRead, SoundFontSeek, SoundFontTell, SoundFontClose);
+    fluidsynth.fluid_synth_add_sfloader(adata->sfont_synth, sfloader);
+    const int sfont_id = fluidsynth.fluid_synth_sfload(adata->sfont_synth, fakefname, 1);
+    if (sfont_id == FLUID_FAILED) {
+        return SDL_SetError("Failed to load FluidSynth soundfont");
+    }
+
+    adata->sfont = fluidsynth.fluid_synth_get_sfont_by_id(adata->sfont_synth, sfont_id);
+    if (!adata->sfont) {
+        return SDL_SetError("Failed to load FluidSynth soundfont");
+    }
+
+    return true;
+}
+
+static void FreeAudioData(FLUIDSYNTH_AudioData *adata)
+{
+    if (adata->sfont_synth) {
+        fluidsynth.delete_fluid_synth(adata->sfont_synth);  // this deletes adata->sfont, too.
+    }
+    if (adata->sfont_settings) {
+        fluidsynth.delete_fluid_settings(adata->sfont_settings);
+    }
+    SDL_DestroyMutex(adata->sfont_lock);
+    SDL_DestroyProperties(adata->fluidsynth_props);
+    MIX_FreeMIDITempoMap(&adata->tempomap);
+    SDL_free(adata);
+}
+
 static bool SDLCALL FLUIDSYNTH_init_audio(SDL_IOStream *io, SDL_AudioSpec *spec, SDL_PropertiesID props, Sint64 *duration_frames, void **audio_userdata)
 {
     // Try to load a soundfont file if we can.
@@ -178,93 +313,46 @@ static bool SDLCALL FLUIDSYNTH_init_audio(SDL_IOStream *io, SDL_AudioSpec *spec,
         return false;
     }
 
-    adata->sfdata = sfdata;
-    adata->sfdatalen = sfdatalen;
-
-    spec->format = SDL_AUDIO_F32;
-    spec->channels = 2;
-    // Use the device's current sample rate, already set in spec->freq
-
-    *duration_frames = -1;  // !!! FIXME: fluid_player_get_total_ticks can give us a time duration, but we don't have a player until we set up the track later.
-    *audio_userdata = adata;
+    // MIDI files are tiny, so pull the whole thing in and map out its tempo changes for the duration and cheap
+    //  seeking later. If this fails, it's not fatal; we just don't know the duration and seek the slow way.
+    bool copied = false;
+    size_t mididatalen = 0;
+    void *mididata = MIX_SlurpConstIO(io, &mididatalen, &copied);
+    if (mididata) {
+        MIX_ParseMIDITempoMap((const Uint8 *) mididata, mididatalen, &adata->tempomap);
+        if (copied) {
+            SDL_free(mididata);
+        }
+    }
 
     const SDL_PropertiesID fluidsynth_props = (SDL_PropertiesID) SDL_GetNumberProperty(props, MIX_PROP_DECODER_FLUIDSYNTH_PROPS_NUMBER, 0);
     if (fluidsynth_props) {
         adata->fluidsynth_props = SDL_CreateProperties();
         if (!adata->fluidsynth_props || !SDL_CopyProperties(fluidsynth_props, adata->fluidsynth_props)) {
-            if (adata->fluidsynth_props) {
-                SDL_DestroyProperties(adata->fluidsynth_props);
-            }
             SDL_free(sfdata);
-            SDL_free(adata);
+            FreeAudioData(adata);
             return false;
         }
     }
 
-    return true;
-}
-
-// this is obnoxious, but you have to implement a whole loader to get a soundfont from memory.
-static void *SoundFontOpen(const char *filename)
-{
-    void *ptr = NULL;
-    if (SDL_sscanf(filename, "&FAKESFNAME&%p", &ptr) != 1) {
-        return NULL;
-    }
-    return ptr;  // (this is actually an SDL_IOStream pointer.)
-}
-
-static int SoundFontRead(void *buf, fluid_long_long_t count, void *handle)
-{
-    #if (SDL_SIZE_MAX < SDL_MAX_SINT64)
-    if (count > (fluid_long_long_t)(SDL_MAX_UINT32)) {
-        return FLUID_FAILED;
-    }
-    #endif
-    if (count < 0) {
-        return FLUID_FAILED;
-    }
-    return (SDL_ReadIO((SDL_IOStream *) handle, buf, count) == (size_t)count) ? FLUID_OK : FLUID_FAILED;
-}
-
-static int SoundFontSeek(void *handle, fluid_long_long_t offset, int origin)
-{
-    SDL_IOWhence whence;
-    switch (origin) {
-        case SEEK_SET: whence = SDL_IO_SEEK_SET; break;
-        case SEEK_CUR: whence = SDL_IO_SEEK_CUR; break;
-        case SEEK_END: whence = SDL_IO_SEEK_END; break;
-        default: return FLUID_FAILED;
+    // FluidSynth reads the whole soundfont into its own structures, so we don't need the raw file once it's parsed.
+    if (sfdata) {
+        const bool okay = LoadSharedSoundFont(adata, sfdata, sfdatalen);
+        SDL_free(sfdata);
+        if (!okay) {
+            FreeAudioData(adata);
+            return false;
+        }
     }
-    return (SDL_SeekIO((SDL_IOStream *) handle, offset, whence) >= 0) ? FLUID_OK : FLUID_FAILED;
-}
 
-static int SoundFontClose(void *handle)
-{
-    SDL_CloseIO((SDL_IOStream *) handle);
-    return FLUID_OK;
-}
+    spec->format = SDL_AUDIO_F32;
+    spec->channels = 2;
+    // Use the device's current sample rate, already set in spec->freq
 
-static fluid_long_long_t SoundFontTell(void *handle)
-{
-    return SDL_TellIO((SDL_IOStream *) handle);
-}
+    *duration_frames = adata->tempomap.changes ? MIX_GetMIDIDurationFrames(&adata->tempomap, spec->freq) : -1;
+    *audio_userdata = adata;
 
-static void SDLCALL SetCustomFluidsynthProperties(void *userdata, SDL_PropertiesID props, const char *name)
-{
-    FLUIDSYNTH_TrackData *tdata = (FLUIDSYNTH_TrackData *) userdata;
-    switch (SDL_GetPropertyType(props, name)) {
-        case SDL_PROPERTY_TYPE_NUMBER:
-            fluidsynth.fluid_settings_setint(tdata->settings, name, (int) SDL_GetNumberProperty(props, name, 0));
-            break;
-        case SDL_PROPERTY_TYPE_FLOAT:
-            fluidsynth.fluid_settings_setnum(tdata->settings, name, (double) SDL_GetFloatProperty(props, name, 0.0f));
-            break;
-        case SDL_PROPERTY_TYPE_STRING:
-            fluidsynth.fluid_settings_setstr(tdata->settings, name, SDL_GetStringProperty(props, name, ""));
-            break;
-        default: break;  // oh well.
-    }
+    return true;
 }
 
 static bool SDLCALL FLUIDSYNTH_init_track(void *audio_userdata, SDL_IOStream *io, const SDL_AudioSpec *spec, SDL_PropertiesID props, void **track_userdata)
@@ -300,7 +388,7 @@ static bool SDLCALL FLUIDSYNTH_init_track(void *audio_userdata, SDL_IOStream *io
     fluidsynth.fluid_settings_setnum(tdata->settings, "synth.reverb.room-size", 0.6);
 
     // let custom properties override anything we already set internally. You break it, you buy it!
-    SDL_EnumerateProperties(adata->fluidsynth_props, SetCustomFluidsynthProperties, tdata);
+    SDL_EnumerateProperties(adata->fluidsynth_props, SetCustomFluidsynthProperties, tdata->settings);
 
     tdata->synth = fluidsynth.new_fluid_synth(tdata->settings);
     if (!tdata->synth) {
@@ -308,21 +396,15 @@ static bool SDLCALL FLUIDSYNTH_init_track(void *audio_userdata, SDL_IOStream *io
         goto failed;
     }
 
-    if (adata->sfdata) {
-        fluid_sfloader_t *sfloader = fluidsynth.new_fluid_defsfloader(tdata->settings);
-        if (!sfloader) {
-            SDL_SetError("Failed to create FluidSynth sfloader");
-            goto failed;
-        }
-
-        char fakefname[64];
-        SDL_snprintf(fakefname, sizeof (fakefname), "&FAKESFNAME&%p", SDL_IOFromConstMem(adata->sfdata, adata->sfdatalen));
-        fluidsynth.fluid_sfloader_set_callbacks(sfloader, SoundFontOpen, SoundFontRead, SoundFontSeek, SoundFontTell, SoundFontClose);
-        fluidsynth.fluid_synth_add_sfloader(tdata->synth, sfloader);
-        if (fluidsynth.fluid_synth_sfload(tdata->synth, fakefname, 1) == FLUID_FAILED) {
-            SDL_SetError("Failed to load FluidSynth soundfont");
+    if (adata->sfont) {
+        SDL_LockMutex(adata->sfont_lock);
+        const bool added = (fluidsynth.fluid_synth_add_sfont(tdata->synth, adata->sfont) != FLUID_FAILED);
+        SDL_UnlockMutex(adata->sfont_lock);
+        if (!added) {
+            SDL_SetError("Failed to add FluidSynth soundfont");
             goto failed;
         }
+        tdata->borrowed_sfont = adata->sfont;
     }
 
     // libfluidsynth doesn't have an abstract loader mechanism, you have to either give it a file path or the whole thing
@@ -368,7 +450,12 @@ failed:
         fluidsynth.delete_fluid_player(tdata->player);
     }
     if (tdata->synth) {
+        SDL_LockMutex(adata->sfont_lock);
+        if (tdata->borrowed_sfont) {
+            fluidsynth.fluid_synth_remove_sfont(tdata->synth, tdata->borrowed_sfont);
+        }
         fluidsynth.delete_fluid_synth(tdata->synth);
+        SDL_UnlockMutex(adata->sfont_lock);
     }
     if (tdata->settings) {
         fluidsynth.delete_fluid_settings(tdata->settings);
@@ -390,7 +477,10 @@ static bool SDLCALL FLUIDSYNTH_decode(void *track_userdata, SDL_AudioStream *str
     }
 
     float samples[256];
-    if (fluidsynth.fluid_synth_write_float(tdata->synth, SDL_arraysize(samples) / 2, samples, 0, 2, samples, 1, 2) != FLUID_OK) {
+    SDL_LockMutex(tdata->adata->sfont_lock);
+    const int rc = fluidsynth.fluid_synth_write_float(tdata->synth, SDL_arraysize(samples) / 2, samples, 0, 2, samples, 1, 2);
+    SDL_UnlockMutex(tdata->adata->sfont_lock);
+    if (rc != FLUID_OK) {
         return false;  // maybe EOF...?
     }
 
@@ -402,6 +492,33 @@ static bool SDLCALL FLUIDSYNTH_decode(void *track_userdata, SDL_AudioStream *str
 static bool SDLCALL FLUIDSYNTH_seek(void *track_userdata, Uint64 frame)
 {
     FLUIDSYNTH_TrackData *tdata = (FLUIDSYNTH_TrackData *) track_userdata;
+    const FLUIDSYNTH_AudioData *adata = tdata->adata;
+
+    // If we have a tempo map, jump the player straight to the right tick. FluidSynth replays the program and
+    //  controller changes up to that point with notes muted, so channels come back in the right state without
+    //  rendering anything. Short forward seeks still render through, so notes already playing don't get cut.
+    const Uint64 render_limit = (Uint64) tdata->freq * FLUIDSYNTH_RENDER_SEEK_SECONDS;
+    const bool can_jump = (adata->tempomap.changes && !adata->tempomap.smpte);  // FluidSynth's player doesn't do SMPTE timing.
+    if (can_jump && ((frame < tdata->current_frame) || ((frame - tdata->current_frame) > render_limit))) {
+        const Uint64 usec = ((frame / tdata->freq) * 1000000) + (((frame % tdata->freq) * 1000000) / tdata->freq);
+        const Uint32 tick = MIX_MIDIMicrosecondsToTicks(&adata->tempomap, usec);
+        if (tick > adata->tempomap.total_ticks) {
+            return SDL_SetError("Seek past end of MIDI file");
+        }
+
+        if (fluidsynth.fluid_player_get_status(tdata->player) != FLUID_PLAYER_PLAYING) {
+            if (fluidsynth.fluid_player_play(tdata->player) != FLUID_OK) {
+                return SDL_SetError("Failed to restart FluidSynth player");
+            }
+        }
+
+        if (fluidsynth.fluid_player_seek(tdata->player, (int) tick) != FLUID_OK) {
+            return SDL_SetError("Couldn't seek MIDI track");
+        }
+
+        tdata->current_frame = frame;
+        return true;
+    }
 
     // This is expensive, but it's not trivial to seek to a specific frame in fluidsynth for various reasons.
     //  (see some explanations in https://github.com/libsdl-org/SDL_mixer/issues/519)
@@ -426,7 +543,10 @@ static bool SDLCALL FLUIDSYNTH_seek(void *track_userdata, Uint64 frame)
 
         float samples[512];
         const Uint64 write_frames = SDL_min((Uint64) (SDL_arraysize(samples) / 2), remaining_frames);
-        if (fluidsynth.fluid_synth_write_float(tdata->synth, (int) write_frames, samples, 0, 2, samples, 1, 2) != FLUID_OK) {
+        SDL_LockMutex(adata->sfont_lock);
+        const int rc = fluidsynth.fluid_synth_write_float(tdata->synth, (int) write_frames, samples, 0, 2, samples, 1, 2);
+        SDL_UnlockMutex(adata->sfont_lock);
+        if (rc != FLUID_OK) {
             return SDL_SetError("Seek past end of MIDI file");  // maybe EOF...?
         }
         tdata->current_frame += write_frames;
@@ -441,17 +561,19 @@ static void SDLCALL FLUIDSYNTH_quit_track(void *track_userdata)
     FLUIDSYNTH_TrackData *tdata = (FLUIDSYNTH_TrackData *) track_userdata;
     fluidsynth.fluid_player_stop(tdata->player);
     fluidsynth.delete_fluid_player(tdata->player);
+    SDL_LockMutex(tdata->adata->sfont_lock);  // releasing this synth's voices touches the shared soundfont's samples, too.
+    if (tdata->borrowed_sfont) {
+        fluidsynth.fluid_synth_remove_sfont(tdata->synth, tdata->borrowed_sfont);  // don't let this synth delete the shared soundfont.
+    }
     fluidsynth.delete_fluid_synth(tdata->synth);
+    SDL_UnlockMutex(tdata->adata->sfont_lock);
     fluidsynth.delete_fluid_settings(tdata->settings);
     SDL_free(tdata);
 }
 
 static void SDLCALL FLUIDSYNTH_quit_audio(void *audio_userdata)
 {
-    FLUIDSYNTH_AudioData *adata = (FLUIDSYNTH_AudioData *) audio_userdata;
-    SDL_DestroyProperties(adata->fluidsynth_props);
-    SDL_free((void *) adata->sfdata);
-    SDL_free(adata);
+    FreeAudioData((FLUIDSYNTH_AudioData *) audio_userdata);
 }
 
 const MIX_Decoder MIX_Decoder_FLUIDSYNTH = {
@@ -462,6 +584,9 @@ const MIX_Decoder MIX_Decoder_FLUIDSYNTH = {
     FLUIDSYNTH_decode,
     FLUIDSYNTH_seek,
     NULL,  // jump_to_order
+    NULL,  // snapshot
+    NULL,  // restore
+    NULL,  // free_snapshot
     FLUIDSYNTH_quit_track,
     FLUIDSYNTH_quit_audio,
     FLUIDSYNTH_quit
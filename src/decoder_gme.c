@@ -54,6 +54,10 @@ SDL_ELF_NOTE_DLOPEN(
 #define MIX_LOADER_MODULE gme
 #include "SDL_mixer_loader.h"
 
+// Render this many sample frames per decode call. libgme is cheap per sample but not per call, and a tiny block
+//  means the mixer has to come back several times to fill each device buffer.
+#define GME_FRAMES_PER_DECODE 1024
+
 
 static bool SDLCALL GME_init(void)
 {
@@ -131,10 +135,10 @@ static bool SDLCALL GME_init_audio(SDL_IOStream *io, SDL_AudioSpec *spec, SDL_Pr
 
     gme.gme_delete(emu);
 
-    // libgme only outputs Sint16 stereo data.
+    // libgme only outputs Sint16 stereo data; there's no float or 32-bit option.
     spec->format = SDL_AUDIO_S16;
     spec->channels = 2;
-    // libgme generates in whatever sample rate, so use the current device spec->freq.
+    // libgme generates in whatever sample rate, so use the current device spec->freq and the stream won't have to resample.
 
     *audio_userdata = NULL;  // no state.
 
@@ -186,7 +190,7 @@ static bool SDLCALL GME_decode(void *track_userdata, SDL_AudioStream *stream)
         return false;  // all done.
     }
 
-    Sint16 samples[256];
+    Sint16 samples[GME_FRAMES_PER_DECODE * 2];
     gme_err_t err = gme.gme_play(emu, SDL_arraysize(samples), (short*) samples);
     if (err != NULL) {
         return SDL_SetError("GME: %s", err);  // i guess we're done.
@@ -233,6 +237,9 @@ const MIX_Decoder MIX_Decoder_GME = {
     GME_decode,
     GME_seek,
     GME_jump_to_order,
+    NULL,  // snapshot
+    NULL,  // restore
+    NULL,  // free_snapshot
     GME_quit_track,
     GME_quit_audio,
     GME_quit
@@ -460,6 +460,9 @@ const MIX_Decoder MIX_Decoder_MPG123 = {
     MPG123_decode,
     MPG123_seek,
     NULL,  // jump_to_order
+    NULL,  // snapshot
+    NULL,  // restore
+    NULL,  // free_snapshot
     MPG123_quit_track,
     MPG123_quit_audio,
     MPG123_quit
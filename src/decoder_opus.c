@@ -56,6 +56,10 @@ SDL_ELF_NOTE_DLOPEN(
 #define MIX_LOADER_MODULE opus
 #include "SDL_mixer_loader.h"
 
+// libopusfile always decodes at 48kHz (it creates the libopus decoder itself and doesn't let us pick a rate, and its
+//  timestamps are all in 48kHz sample frames), so we can't ask for the mixer's rate here; the track's audio stream resamples.
+//  What we _can_ do is ask for a whole packet at a time instead of making op_read_float split it across many calls.
+#define OPUS_DECODE_FRAMES 960   // 20 milliseconds at 48kHz, which is the most common Opus packet size.
 
 typedef struct OPUS_AudioData
 {
@@ -66,6 +70,8 @@ typedef struct OPUS_TrackData
 {
     const OPUS_AudioData *adata;
     OggOpusFile *of;
+    float *samples;
+    int samples_allocated;  // in floats, not bytes or frames.
     int current_channels;
     int current_bitstream;
     Sint64 current_iteration;
@@ -214,6 +220,14 @@ static bool SDLCALL OPUS_init_track(void *audio_userdata, SDL_IOStream *io, cons
         return set_op_error("op_open_callbacks", rc);
     }
 
+    tdata->samples_allocated = OPUS_DECODE_FRAMES * spec->channels;
+    tdata->samples = (float *) SDL_malloc(tdata->samples_allocated * sizeof (float));
+    if (!tdata->samples) {
+        opus.op_free(tdata->of);
+        SDL_free(tdata);
+        return false;
+    }
+
     tdata->current_channels = spec->channels;
     tdata->current_bitstream = -1;
     tdata->current_iteration = -1;
@@ -230,18 +244,14 @@ static bool SDLCALL OPUS_decode(void *track_userdata, SDL_AudioStream *stream)
 {
     OPUS_TrackData *tdata = (OPUS_TrackData *) track_userdata;
     int bitstream = tdata->current_bitstream;
-    float samples[256];
 
-    const int channels = tdata->current_channels;
-    int amount = opus.op_read_float(tdata->of, samples, SDL_arraysize(samples), &bitstream);
+    int amount = opus.op_read_float(tdata->of, tdata->samples, tdata->samples_allocated, &bitstream);
     if (amount < 0) {
         return set_op_error("op_read_float", amount);
     } else if (amount == 0) {
         return false;  // EOF
     }
 
-    SDL_assert((amount * channels) <= (int)SDL_arraysize(samples));
-
     if (bitstream != tdata->current_bitstream) {
         const OpusHead *info = opus.op_head(tdata->of, -1);
         if (info) {  // this _shouldn't_ be NULL, but if it is, we're just going on without it and hoping the stream format didn't change.
@@ -249,11 +259,23 @@ static bool SDLCALL OPUS_decode(void *track_userdata, SDL_AudioStream *stream)
                 const SDL_AudioSpec spec = { SDL_AUDIO_F32, info->channel_count, 48000 };
                 SDL_SetAudioStreamFormat(stream, &spec, NULL);
                 tdata->current_channels = info->channel_count;
+
+                // keep room for a full packet at the new channel count. If this fails, we'll just decode in smaller pieces.
+                const int needed = OPUS_DECODE_FRAMES * info->channel_count;
+                if (needed > tdata->samples_allocated) {
+                    void *ptr = SDL_realloc(tdata->samples, needed * sizeof (float));
+                    if (ptr) {
+                        tdata->samples = (float *) ptr;
+                        tdata->samples_allocated = needed;
+                    }
+                }
             }
         }
         tdata->current_bitstream = bitstream;
     }
 
+    SDL_assert((amount * tdata->current_channels) <= tdata->samples_allocated);
+
     const MIX_OggLoop *loop = &tdata->adata->loop;
     if (tdata->current_iteration < 0) {
         if (loop->active && ((tdata->current_iteration_frames + amount) >= loop->start)) {
@@ -297,7 +319,7 @@ static bool SDLCALL OPUS_decode(void *track_userdata, SDL_AudioStream *stream)
     }
 
     if (amount > 0) {
-        SDL_PutAudioStreamData(stream, samples, amount * tdata->current_channels * sizeof (float));
+        SDL_PutAudioStreamData(stream, tdata->samples, amount * tdata->current_channels * sizeof (float));
         tdata->current_iteration_frames += amount;
     }
 
@@ -342,6 +364,7 @@ static void SDLCALL OPUS_quit_track(void *track_userdata)
 {
     OPUS_TrackData *tdata = (OPUS_TrackData *) track_userdata;
     opus.op_free(tdata->of);
+    SDL_free(tdata->samples);
     SDL_free(tdata);
 }
 
@@ -359,6 +382,9 @@ const MIX_Decoder MIX_Decoder_OPUS = {
     OPUS_decode,
     OPUS_seek,
     NULL,  // jump_to_order
+    NULL,  // snapshot
+    NULL,  // restore
+    NULL,  // free_snapshot
     OPUS_quit_track,
     OPUS_quit_audio,
     OPUS_quit
@@ -138,6 +138,9 @@ const MIX_Decoder MIX_Decoder_RAW = {
     RAW_decode,
     RAW_seek,
     NULL,  // jump_to_order
+    NULL,  // snapshot
+    NULL,  // restore
+    NULL,  // free_snapshot
     RAW_quit_track,
     RAW_quit_audio,
     NULL  // quit
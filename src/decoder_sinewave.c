@@ -161,6 +161,9 @@ const MIX_Decoder MIX_Decoder_SINEWAVE = {
     SINEWAVE_decode,
     SINEWAVE_seek,
     NULL,  // jump_to_order
+    NULL,  // snapshot
+    NULL,  // restore
+    NULL,  // free_snapshot
     SINEWAVE_quit_track,
     SINEWAVE_quit_audio,
     NULL  // quit
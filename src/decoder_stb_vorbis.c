@@ -106,6 +106,7 @@ static bool SetStbVorbisError(const char *function, int error)
 
 typedef struct STBVORBIS_AudioData
 {
+    stb_vorbis *setup;  // parsed setup headers (codebooks, etc), shared read-only with every track. We never decode with this one.
     MIX_OggLoop loop;
 } STBVORBIS_AudioData;
 
@@ -174,7 +175,10 @@ static bool SDLCALL STBVORBIS_init_audio(SDL_IOStream *io, SDL_AudioSpec *spec,
     if (adata->loop.end > full_length) {
         adata->loop.active = false;
     }
-    stb_vorbis_close(vorbis);  // done with this instance. Tracks will maintain their own stb_vorbis object.
+
+    // Keep this instance around, so tracks can share its setup data instead of parsing it again.
+    // Tracks will maintain their own stb_vorbis object for the per-stream state, and this one never touches `io` again.
+    adata->setup = vorbis;
 
     if (adata->loop.active) {
         *duration_frames = (adata->loop.count < 0) ? MIX_DURATION_INFINITE : (full_length * adata->loop.count);
@@ -194,15 +198,25 @@ static bool SDLCALL STBVORBIS_init_track(void *audio_userdata, SDL_IOStream *io,
         return false;
     }
 
+    const STBVORBIS_AudioData *adata = (const STBVORBIS_AudioData *) audio_userdata;
     int error = 0;
     tdata->current_iteration = -1;
-    tdata->vorbis = stb_vorbis_open_io(io, 0, &error, NULL);
+    tdata->vorbis = stb_vorbis_open_io_with_setup(io, 0, &error, adata->setup);
+    if (!tdata->vorbis && (error == VORBIS_feature_not_supported)) {
+        // headers don't end on a page boundary, so we have to parse them all again.
+        if (SDL_SeekIO(io, 0, SDL_IO_SEEK_SET) < 0) {
+            SDL_free(tdata);
+            return false;
+        }
+        tdata->vorbis = stb_vorbis_open_io(io, 0, &error, NULL);
+    }
+
     if (!tdata->vorbis) {
         SDL_free(tdata);
         return SetStbVorbisError("stb_vorbis_open_io", error);
     }
 
-    tdata->adata = (const STBVORBIS_AudioData *) audio_userdata;
+    tdata->adata = adata;
 
     *track_userdata = tdata;
 
@@ -346,7 +360,9 @@ static void SDLCALL STBVORBIS_quit_track(void *track_userdata)
 
 static void SDLCALL STBVORBIS_quit_audio(void *audio_userdata)
 {
-    SDL_free(audio_userdata);
+    STBVORBIS_AudioData *adata = (STBVORBIS_AudioData *) audio_userdata;
+    stb_vorbis_close(adata->setup);
+    SDL_free(adata);
 }
 
 const MIX_Decoder MIX_Decoder_STBVORBIS = {
@@ -357,6 +373,9 @@ const MIX_Decoder MIX_Decoder_STBVORBIS = {
     STBVORBIS_decode,
     STBVORBIS_seek,
     NULL,  // jump_to_order
+    NULL,  // snapshot
+    NULL,  // restore
+    NULL,  // free_snapshot
     STBVORBIS_quit_track,
     STBVORBIS_quit_audio,
     STBVORBIS_quit
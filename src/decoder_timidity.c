@@ -27,7 +27,11 @@
 
 #include "timidity/timidity.h"
 
-#define SAMPLES_PER_DECODE 256
+// Sample frames rendered per decode call, unless MIX_PROP_DECODER_TIMIDITY_FRAMES_PER_DECODE_NUMBER says otherwise.
+//  Envelopes update every CONTROLS_PER_SECOND regardless, so bigger blocks mostly just save call overhead.
+#define DEFAULT_FRAMES_PER_DECODE 1024
+#define MIN_FRAMES_PER_DECODE 64
+#define MAX_FRAMES_PER_DECODE 4096
 
 // Config file should contain any other directory that needs
 //  to be added to the search path. The library adds the path
@@ -42,6 +46,8 @@ typedef struct TIMIDITY_TrackData
 {
     MidiSong *song;
     int freq;
+    float *samples;
+    int frames_per_decode;
 } TIMIDITY_TrackData;
 
 
@@ -83,47 +89,79 @@ static bool SDLCALL TIMIDITY_init_audio(SDL_IOStream *io, SDL_AudioSpec *spec, S
         return SDL_SetError("Not a MIDI audio stream");
     }
 
-    // Go back and do a proper load now to get metadata.
-    if (SDL_SeekIO(io, 0, SDL_IO_SEEK_SET) < 0) {
-        return false;
-    }
-
-    spec->format = SDL_AUDIO_S32;   // timidity wants to do Sint32, and converts to other formats internally from Sint32.
+    spec->format = SDL_AUDIO_F32;   // timidity mixes in Sint32, but converts to float itself on the way out, which saves the track a conversion.
     spec->channels = 2;
     // Use the device's current sample rate, already set in spec->freq
 
-    Sint64 song_length_in_frames = -1;
-    MidiSong *song = Timidity_LoadSong(io, spec, SAMPLES_PER_DECODE);
-    if (!song) {
+    // Scan the event stream for the song length, and index it for seeking. We don't build a playable MidiSong here,
+    //  since that would load every instrument the song uses; that waits until a track actually plays it.
+    bool copied = false;
+    size_t datalen = 0;
+    void *data = MIX_SlurpConstIO(io, &datalen, &copied);
+    if (!data) {
+        return false;
+    }
+
+    MIX_MIDITempoMap tempomap;
+    if (!MIX_ParseMIDITempoMap((const Uint8 *) data, datalen, &tempomap)) {
+        if (copied) {
+            SDL_free(data);
+        }
         return false;
     }
 
-    song_length_in_frames = MIX_MSToFrames(spec->freq, Timidity_GetSongLength(song));
-    if (song_length_in_frames < 0) {
-        song_length_in_frames = 0;
+    const Sint64 song_length_in_frames = MIX_GetMIDIDurationFrames(&tempomap, spec->freq);
+    MIX_FreeMIDITempoMap(&tempomap);
+
+    // Every track plays this at spec->freq, so they can all share one seek index. If it can't be built, they
+    //  just seek by replaying from the start.
+    MidiSeekIndex *seek_index = NULL;
+    SDL_IOStream *dataio = SDL_IOFromConstMem(data, datalen);
+    if (dataio) {
+        seek_index = Timidity_BuildSeekIndex(dataio, spec);
+        SDL_CloseIO(dataio);
+    }
+    if (copied) {
+        SDL_free(data);
     }
-    Timidity_FreeSong(song);
 
     *duration_frames = song_length_in_frames;
-    *audio_userdata = NULL;   // no state.
+    *audio_userdata = seek_index;  // may be NULL.
 
     return true;
 }
 
 static bool SDLCALL TIMIDITY_init_track(void *audio_userdata, SDL_IOStream *io, const SDL_AudioSpec *spec, SDL_PropertiesID props, void **track_userdata)
 {
-    SDL_assert(audio_userdata == NULL);  // no state.
     TIMIDITY_TrackData *tdata = (TIMIDITY_TrackData *) SDL_calloc(1, sizeof (*tdata));
     if (!tdata) {
         return false;
     }
 
-    tdata->song = Timidity_LoadSong(io, spec, SAMPLES_PER_DECODE);
+    // this is read from the MIX_Audio's properties each time a track starts, so it can be changed between tracks, too.
+    const Sint64 frames = SDL_GetNumberProperty(props, MIX_PROP_DECODER_TIMIDITY_FRAMES_PER_DECODE_NUMBER, DEFAULT_FRAMES_PER_DECODE);
+    tdata->frames_per_decode = (int) SDL_clamp(frames, MIN_FRAMES_PER_DECODE, MAX_FRAMES_PER_DECODE);
+    tdata->samples = (float *) SDL_malloc(tdata->frames_per_decode * 2/*channels*/ * sizeof (float));
+    if (!tdata->samples) {
+        SDL_free(tdata);
+        return false;
+    }
+
+    tdata->song = Timidity_LoadSong(io, spec, tdata->frames_per_decode);
     if (!tdata->song) {
+        SDL_free(tdata->samples);
         SDL_free(tdata);
         return SDL_SetError("Timidity_LoadSong failed");
     }
 
+    // Dense songs can spread their voices over several threads. The output is identical either way, so if the
+    //  threads can't be started, just carry on with one.
+    const Sint64 threads = SDL_GetNumberProperty(props, MIX_PROP_DECODER_TIMIDITY_THREADS_NUMBER, 1);
+    if (threads > 1) {
+        Timidity_SetThreads(tdata->song, (int) SDL_min(threads, SDL_GetNumLogicalCPUCores()));
+    }
+
+    Timidity_SetSeekIndex(tdata->song, (const MidiSeekIndex *) audio_userdata);
     Timidity_SetVolume(tdata->song, 800);  // !!! FIXME: maybe my test patches are really quiet?
     Timidity_Start(tdata->song);
 
@@ -136,13 +174,12 @@ static bool SDLCALL TIMIDITY_init_track(void *audio_userdata, SDL_IOStream *io,
 static bool SDLCALL TIMIDITY_decode(void *track_userdata, SDL_AudioStream *stream)
 {
     TIMIDITY_TrackData *tdata = (TIMIDITY_TrackData *) track_userdata;
-    Sint32 samples[SAMPLES_PER_DECODE * 2/*channels*/];
-    const int amount = Timidity_PlaySome(tdata->song, samples, sizeof (samples));
+    const int amount = Timidity_PlaySome(tdata->song, tdata->samples, tdata->frames_per_decode * 2/*channels*/ * sizeof (float));
     if (amount <= 0) {
         return false;  // EOF or error, we're done either way.
     }
 
-    SDL_PutAudioStreamData(stream, samples, amount);
+    SDL_PutAudioStreamData(stream, tdata->samples, amount);
     return true;
 }
 
@@ -153,21 +190,42 @@ static bool SDLCALL TIMIDITY_seek(void *track_userdata, Uint64 frame)
     if (ticks < 0) {
         ticks = 0;
     }
-    Timidity_Seek(tdata->song, (Uint32)ticks);  // !!! FIXME: this returns void, what happens if we seek past EOF?
+    if (!Timidity_Seek(tdata->song, (Uint32)ticks)) {
+        return SDL_SetError("Seek past end of MIDI file");
+    }
+    return true;
+}
+
+static void *SDLCALL TIMIDITY_snapshot(void *track_userdata)
+{
+    TIMIDITY_TrackData *tdata = (TIMIDITY_TrackData *) track_userdata;
+    return Timidity_SaveState(tdata->song);
+}
+
+static bool SDLCALL TIMIDITY_restore(void *track_userdata, const void *snapshot)
+{
+    TIMIDITY_TrackData *tdata = (TIMIDITY_TrackData *) track_userdata;
+    Timidity_RestoreState(tdata->song, (const MidiSongState *) snapshot);
     return true;
 }
 
+static void SDLCALL TIMIDITY_free_snapshot(void *snapshot)
+{
+    Timidity_FreeState((MidiSongState *) snapshot);
+}
+
 static void SDLCALL TIMIDITY_quit_track(void *track_userdata)
 {
     TIMIDITY_TrackData *tdata = (TIMIDITY_TrackData *) track_userdata;
     Timidity_Stop(tdata->song);
     Timidity_FreeSong(tdata->song);
+    SDL_free(tdata->samples);
     SDL_free(tdata);
 }
 
 static void SDLCALL TIMIDITY_quit_audio(void *audio_userdata)
 {
-    SDL_assert(audio_userdata == NULL);  // no state.
+    Timidity_FreeSeekIndex((MidiSeekIndex *) audio_userdata);
 }
 
 const MIX_Decoder MIX_Decoder_TIMIDITY = {
@@ -178,6 +236,9 @@ const MIX_Decoder MIX_Decoder_TIMIDITY = {
     TIMIDITY_decode,
     TIMIDITY_seek,
     NULL,  // jump_to_order
+    TIMIDITY_snapshot,
+    TIMIDITY_restore,
+    TIMIDITY_free_snapshot,
     TIMIDITY_quit_track,
     TIMIDITY_quit_audio,
     TIMIDITY_quit
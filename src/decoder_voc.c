@@ -600,6 +600,9 @@ const MIX_Decoder MIX_Decoder_VOC = {
     VOC_decode,
     VOC_seek,
     NULL,  // jump_to_order
+    NULL,  // snapshot
+    NULL,  // restore
+    NULL,  // free_snapshot
     VOC_quit_track,
     VOC_quit_audio,
     NULL  // quit
@@ -453,6 +453,9 @@ const MIX_Decoder MIX_Decoder_VORBIS = {
     VORBIS_decode,
     VORBIS_seek,
     NULL,  // jump_to_order
+    NULL,  // snapshot
+    NULL,  // restore
+    NULL,  // free_snapshot
     VORBIS_quit_track,
     VORBIS_quit_audio,
     VORBIS_quit
@@ -1801,6 +1801,9 @@ const MIX_Decoder MIX_Decoder_WAV = {
     WAV_decode,
     WAV_seek,
     NULL,  // jump_to_order
+    NULL,  // snapshot
+    NULL,  // restore
+    NULL,  // free_snapshot
     WAV_quit_track,
     WAV_quit_audio,
     NULL  // quit
@@ -634,6 +634,9 @@ const MIX_Decoder MIX_Decoder_WAVPACK = {
     WAVPACK_decode,
     WAVPACK_seek,
     NULL,  // jump_to_order
+    NULL,  // snapshot
+    NULL,  // restore
+    NULL,  // free_snapshot
     WAVPACK_quit_track,
     WAVPACK_quit_audio,
     WAVPACK_quit
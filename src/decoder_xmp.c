@@ -110,9 +110,15 @@ static bool SetLibXmpError(const char *function, int error)
     return SDL_SetError("%s: unknown error %d", function, error);
 }
 
+// xmp_play_frame() renders one module tick (about 20 milliseconds at 125 BPM), so keep going until we have at
+//  least this many sample frames, to cut down on how often the mixer has to call back in to fill a buffer.
+#define XMP_MIN_FRAMES_PER_DECODE 2048
+
 typedef struct XMP_TrackData
 {
     int freq;
+    int format;  // XMP_FORMAT_* flags for xmp_start_player.
+    int frame_size;  // bytes per sample frame.
     xmp_context ctx;
 } XMP_TrackData;
 
@@ -198,10 +204,11 @@ static bool SDLCALL XMP_init_audio(SDL_IOStream *io, SDL_AudioSpec *spec, SDL_Pr
     libxmp.xmp_release_module(ctx);
     libxmp.xmp_free_context(ctx);
 
-    // libxmp prefers to generate Sint16, stereo data.
+    // libxmp only generates Sint16 (or 8-bit) data, so no float here. It can do mono, though, so if the mixer is
+    //  mono, don't make the stream downmix stereo for us.
     spec->format = SDL_AUDIO_S16;
-    spec->channels = 2;
-    // libxmp generates in whatever sample rate, so use the current device spec->freq.
+    spec->channels = (spec->channels == 1) ? 1 : 2;
+    // libxmp generates in whatever sample rate, so use the current device spec->freq and the stream won't have to resample.
 
     *audio_userdata = NULL;  // no state.
 
@@ -220,6 +227,8 @@ static bool SDLCALL XMP_init_track(void *audio_userdata, SDL_IOStream *io, const
     }
 
     tdata->freq = spec->freq;
+    tdata->format = (spec->channels == 1) ? XMP_FORMAT_MONO : 0;
+    tdata->frame_size = (int) (sizeof (Sint16) * spec->channels);
 
     tdata->ctx = libxmp.xmp_create_context();
     if (!tdata->ctx) {
@@ -234,7 +243,7 @@ static bool SDLCALL XMP_init_track(void *audio_userdata, SDL_IOStream *io, const
         return SetLibXmpError("xmp_load_module_from_memory", err);
     }
 
-    err = libxmp.xmp_start_player(tdata->ctx, spec->freq, 0);
+    err = libxmp.xmp_start_player(tdata->ctx, spec->freq, tdata->format);
     if (err) {
         libxmp.xmp_release_module(tdata->ctx);
         libxmp.xmp_free_context(tdata->ctx);
@@ -250,19 +259,23 @@ static bool SDLCALL XMP_init_track(void *audio_userdata, SDL_IOStream *io, const
 static bool SDLCALL XMP_decode(void *track_userdata, SDL_AudioStream *stream)
 {
     XMP_TrackData *tdata = (XMP_TrackData *) track_userdata;
+    int frames = 0;
 
-    if (libxmp.xmp_play_frame(tdata->ctx) < 0) {
-        return false;  // either an error or EOF, either way we're done.
-    }
+    while (frames < XMP_MIN_FRAMES_PER_DECODE) {
+        if (libxmp.xmp_play_frame(tdata->ctx) < 0) {
+            return (frames > 0);  // either an error or EOF, either way we're done (after whatever we already put).
+        }
 
-    struct xmp_frame_info info;
-    libxmp.xmp_get_frame_info(tdata->ctx, &info);
+        struct xmp_frame_info info;
+        libxmp.xmp_get_frame_info(tdata->ctx, &info);
 
-    if (info.loop_count > 0) {
-        return false;  // if we looped, we're at the EOF. !!! FIXME: do _all_ formats loop, or should we honor this?
-    }
+        if (info.loop_count > 0) {
+            return (frames > 0);  // if we looped, we're at the EOF. !!! FIXME: do _all_ formats loop, or should we honor this?
+        }
 
-    SDL_PutAudioStreamData(stream, info.buffer, info.buffer_size);
+        SDL_PutAudioStreamData(stream, info.buffer, info.buffer_size);
+        frames += info.buffer_size / tdata->frame_size;
+    }
 
     return true;  // had more data to decode.
 }
@@ -314,6 +327,9 @@ const MIX_Decoder MIX_Decoder_XMP = {
     XMP_decode,
     XMP_seek,
     XMP_jump_to_order,
+    NULL,  // snapshot
+    NULL,  // restore
+    NULL,  // free_snapshot
     XMP_quit_track,
     XMP_quit_audio,
     XMP_quit
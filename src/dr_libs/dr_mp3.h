@@ -58,6 +58,10 @@ Build Options
 
 #define DR_MP3_NO_SIMD
   Disable SIMD optimizations.
+
+#define DRMP3_NO_PARSE_METADATA_TAGS
+  Don't look for ID3v1, ID3v2 or APE tags during initialization. Use this if the tags have already been stripped from the
+  stream by the application, as this saves several seeks and reads per drmp3_init(). The metadata callback will never fire.
 */
 
 #ifndef dr_mp3_h
@@ -2972,7 +2976,7 @@ static drmp3_bool32 drmp3_init_internal(drmp3* pMP3, drmp3_read_proc onRead, drm
     pMP3->totalPCMFrameCount = DRMP3_UINT64_MAX;
 
     /* We'll first check for any ID3v1 or APE tags. */
-    #if 1
+    #ifndef DRMP3_NO_PARSE_METADATA_TAGS
     if (onSeek != NULL && onTell != NULL) {
         if (onSeek(pUserData, 0, DRMP3_SEEK_END)) {
             drmp3_int64 streamLen;
@@ -3074,7 +3078,7 @@ static drmp3_bool32 drmp3_init_internal(drmp3* pMP3, drmp3_read_proc onRead, drm
 
 
     /* ID3v2 tags */
-    #if 1
+    #ifndef DRMP3_NO_PARSE_METADATA_TAGS
     {
         char header[10];
         if (onRead(pUserData, header, 10) == 10) {
@@ -3431,7 +3435,7 @@ DRMP3_API drmp3_bool32 drmp3_init_memory_with_metadata(drmp3* pMP3, const void*
     }
 
     /* Adjust the length of the memory stream to account for ID3v1 and APE tags. */
-    if (pMP3->streamLength <= (drmp3_uint64)DRMP3_SIZE_MAX) {
+    if (pMP3->streamLength != DRMP3_UINT64_MAX && pMP3->streamLength <= (drmp3_uint64)DRMP3_SIZE_MAX) {
         pMP3->memory.dataSize = (size_t)pMP3->streamLength; /* Safe cast. */
     }
 
@@ -308,6 +308,15 @@ extern stb_vorbis * stb_vorbis_open_file_section(FILE *f, int close_handle_on_cl
 #ifdef STB_VORBIS_SDL
 extern stb_vorbis * stb_vorbis_open_io_section(SDL_IOStream *io, int close_on_free, int *error, const stb_vorbis_alloc *alloc, unsigned int length);
 extern stb_vorbis * stb_vorbis_open_io(SDL_IOStream *io, int close_on_free, int *error, const stb_vorbis_alloc *alloc);
+extern stb_vorbis * stb_vorbis_open_io_with_setup(SDL_IOStream *io, int close_on_free, int *error, const stb_vorbis *setup);
+// create an ogg vorbis decoder that reuses the already-parsed setup headers
+// (codebooks, floors, residues, mappings, modes, and the per-blocksize tables)
+// of 'setup', which must be an open stb_vorbis for the same stream. Only the
+// per-stream decode state is allocated, and the header packets are skipped,
+// not reparsed. 'setup' must outlive the returned decoder, and must not be
+// used to decode while it is shared, since none of the shared data is
+// modified after setup. Fails with VORBIS_feature_not_supported if the
+// headers don't end on a page boundary; use stb_vorbis_open_io() then.
 #define IO_BUFFER_SIZE 2048
 #endif
 
@@ -850,6 +859,8 @@ struct stb_vorbis
    uint32 io_buffer_fill;
    uint8 io_buffer[IO_BUFFER_SIZE];
    int close_on_free;
+   int shared_setup;  // if true, setup data belongs to another stb_vorbis and must not be freed.
+   int longest_floorlist;
 #endif
 
    const uint8 *stream;
@@ -3736,6 +3747,23 @@ static int is_whole_packet_present(stb_vorbis *f)
 }
 #endif // !STB_VORBIS_NO_PUSHDATA_API
 
+static int init_channel_buffers(vorb *f, int longest_floorlist)
+{
+   int i;
+   for (i=0; i < f->channels; ++i) {
+      f->channel_buffers[i] = (float *) setup_malloc(f, sizeof(float) * f->blocksize_1);
+      f->previous_window[i] = (float *) setup_malloc(f, sizeof(float) * f->blocksize_1/2);
+      f->finalY[i]          = (int16 *) setup_malloc(f, sizeof(int16) * longest_floorlist);
+      if (f->channel_buffers[i] == NULL || f->previous_window[i] == NULL || f->finalY[i] == NULL) return error(f, VORBIS_outofmem);
+      memset(f->channel_buffers[i], 0, sizeof(float) * f->blocksize_1);
+      #ifdef STB_VORBIS_NO_DEFER_FLOOR
+      f->floor_buffers[i]   = (float *) setup_malloc(f, sizeof(float) * f->blocksize_1/2);
+      if (f->floor_buffers[i] == NULL) return error(f, VORBIS_outofmem);
+      #endif
+   }
+   return TRUE;
+}
+
 static int start_decoder(vorb *f)
 {
    uint8 header[6], x,y;
@@ -4316,17 +4344,11 @@ static int start_decoder(vorb *f)
 
    f->previous_length = 0;
 
-   for (i=0; i < f->channels; ++i) {
-      f->channel_buffers[i] = (float *) setup_malloc(f, sizeof(float) * f->blocksize_1);
-      f->previous_window[i] = (float *) setup_malloc(f, sizeof(float) * f->blocksize_1/2);
-      f->finalY[i]          = (int16 *) setup_malloc(f, sizeof(int16) * longest_floorlist);
-      if (f->channel_buffers[i] == NULL || f->previous_window[i] == NULL || f->finalY[i] == NULL) return error(f, VORBIS_outofmem);
-      memset(f->channel_buffers[i], 0, sizeof(float) * f->blocksize_1);
-      #ifdef STB_VORBIS_NO_DEFER_FLOOR
-      f->floor_buffers[i]   = (float *) setup_malloc(f, sizeof(float) * f->blocksize_1/2);
-      if (f->floor_buffers[i] == NULL) return error(f, VORBIS_outofmem);
-      #endif
-   }
+   #ifdef STB_VORBIS_SDL
+   f->longest_floorlist = longest_floorlist;
+   #endif
+
+   if (!init_channel_buffers(f, longest_floorlist)) return FALSE;
 
    if (!init_blocksize(f, 0, f->blocksize_0)) return FALSE;
    if (!init_blocksize(f, 1, f->blocksize_1)) return FALSE;
@@ -4401,6 +4423,10 @@ static void vorbis_deinit(stb_vorbis *p)
 {
    int i,j;
 
+   #ifdef STB_VORBIS_SDL
+   if (p->shared_setup) goto free_stream_data;  // everything up to the channel buffers belongs to someone else.
+   #endif
+
 #ifndef STB_VORBIS_NO_COMMENTS
    setup_free(p, p->vendor);
    for (i=0; i < p->comment_list_length; ++i) {
@@ -4442,6 +4468,10 @@ static void vorbis_deinit(stb_vorbis *p)
          setup_free(p, p->mapping[i].chan);
       setup_free(p, p->mapping);
    }
+
+   #ifdef STB_VORBIS_SDL
+free_stream_data:
+   #endif
    CHECK(p);
    for (i=0; i < p->channels && i < STB_VORBIS_MAX_CHANNELS; ++i) {
       setup_free(p, p->channel_buffers[i]);
@@ -4451,6 +4481,9 @@ static void vorbis_deinit(stb_vorbis *p)
       #endif
       setup_free(p, p->finalY[i]);
    }
+   #ifdef STB_VORBIS_SDL
+   if (!p->shared_setup)
+   #endif
    for (i=0; i < 2; ++i) {
       setup_free(p, p->A[i]);
       setup_free(p, p->B[i]);
@@ -4500,6 +4533,8 @@ static void vorbis_init(stb_vorbis *p, const stb_vorbis_alloc *z)
    p->io_virtual_pos = 0;
    p->io_buffer_pos = 0;
    p->io_buffer_fill = 0;
+   p->shared_setup = FALSE;
+   p->longest_floorlist = 0;
    #endif
    #ifndef STB_VORBIS_NO_STDIO
    p->close_on_free = FALSE;
@@ -5360,6 +5395,85 @@ stb_vorbis * stb_vorbis_open_io(SDL_IOStream *io, int close_on_free, int *error,
    const unsigned int len = (unsigned int) (SDL_GetIOSize(io) - start);
    return stb_vorbis_open_io_section(io, close_on_free, error, alloc, len);
 }
+
+stb_vorbis * stb_vorbis_open_io_with_setup(SDL_IOStream *io, int close_on_free, int *error, const stb_vorbis *setup)
+{
+   stb_vorbis *f, p;
+   const unsigned int start = (unsigned int) SDL_TellIO(io);
+
+   // we can only skip the headers if the first audio packet starts on a fresh page.
+   // (and we don't support the caller's static alloc_buffer, as the setup data isn't in it.)
+   if (!setup->first_audio_page_offset || setup->alloc.alloc_buffer) {
+      if (error) *error = VORBIS_feature_not_supported;
+      return NULL;
+   }
+
+   vorbis_init(&p, NULL);
+   p.io = io;
+   p.io_start = start;
+   p.stream_len = (unsigned int) (SDL_GetIOSize(io) - start);
+   p.close_on_free = close_on_free;
+   p.shared_setup = TRUE;
+
+   // everything here is read-only once start_decoder() is done with it.
+   p.sample_rate = setup->sample_rate;
+   p.channels = setup->channels;
+   p.setup_memory_required = setup->setup_memory_required;
+   p.temp_memory_required = setup->temp_memory_required;
+   p.setup_temp_memory_required = setup->setup_temp_memory_required;
+   #ifndef STB_VORBIS_NO_COMMENTS
+   p.vendor = setup->vendor;
+   p.comment_list_length = setup->comment_list_length;
+   p.comment_list = setup->comment_list;
+   #endif
+   p.first_audio_page_offset = setup->first_audio_page_offset;
+   p.blocksize[0] = setup->blocksize[0];
+   p.blocksize[1] = setup->blocksize[1];
+   p.blocksize_0 = setup->blocksize_0;
+   p.blocksize_1 = setup->blocksize_1;
+   p.codebook_count = setup->codebook_count;
+   p.codebooks = setup->codebooks;
+   p.floor_count = setup->floor_count;
+   memcpy(p.floor_types, setup->floor_types, sizeof (p.floor_types));
+   p.floor_config = setup->floor_config;
+   p.residue_count = setup->residue_count;
+   memcpy(p.residue_types, setup->residue_types, sizeof (p.residue_types));
+   p.residue_config = setup->residue_config;
+   p.mapping_count = setup->mapping_count;
+   p.mapping = setup->mapping;
+   p.mode_count = setup->mode_count;
+   memcpy(p.mode_config, setup->mode_config, sizeof (p.mode_config));
+   p.total_samples = setup->total_samples;
+   p.longest_floorlist = setup->longest_floorlist;
+   memcpy(p.A, setup->A, sizeof (p.A));
+   memcpy(p.B, setup->B, sizeof (p.B));
+   memcpy(p.C, setup->C, sizeof (p.C));
+   memcpy(p.window, setup->window, sizeof (p.window));
+   memcpy(p.bit_reverse, setup->bit_reverse, sizeof (p.bit_reverse));
+
+   // now the per-stream state.
+   p.previous_length = 0;
+   if (init_channel_buffers(&p, p.longest_floorlist)) {
+      p.work_buffer = setup_malloc(&p, p.temp_memory_required);
+      if (p.work_buffer == NULL) {
+         p.error = VORBIS_outofmem;
+      } else if (set_file_offset(&p, p.first_audio_page_offset)) {
+         p.first_decode = TRUE;
+         p.next_seg = -1;
+         f = vorbis_alloc(&p);
+         if (f) {
+            memcpy(f, &p, sizeof (stb_vorbis));
+            vorbis_pump_first_frame(f);
+            return f;
+         }
+      } else {
+         p.error = VORBIS_seek_failed;
+      }
+   }
+   if (error) *error = p.error;
+   vorbis_deinit(&p);
+   return NULL;
+}
 #endif
 
 stb_vorbis * stb_vorbis_open_memory(const unsigned char *data, int len, int *error, const stb_vorbis_alloc *alloc)
@@ -21,6 +21,24 @@ extern void timi_free_pathlist(void);
 #undef  TIMI_NAMESPACE
 #define TIMI_NAMESPACE(x) _timi_ ## x
 
+/* CPU features for the SIMD paths in mix.c and resample.c, set once by
+   Timidity_Init. NEON is always there on the same chips SDL_mixer assumes. */
+#ifdef SDL_SSE2_INTRINSICS
+#define timi_has_sse2 TIMI_NAMESPACE(has_sse2)
+extern bool timi_has_sse2;
+#endif
+#ifdef SDL_NEON_INTRINSICS
+#if (defined(__ARM_ARCH) && (__ARM_ARCH >= 8)) || \
+    (defined(__APPLE__) && defined(__ARM_ARCH) && (__ARM_ARCH >= 7)) || \
+    ((defined(__WINDOWS__) || defined(__WINRT__)) && defined(_M_ARM))
+#define timi_has_neon 1
+#else
+#define timi_has_neon TIMI_NAMESPACE(has_neon)
+extern bool timi_has_neon;
+#define TIMI_NEED_NEON_CHECK 1
+#endif
+#endif
+
 /*#define DEBUG_CHATTER 1*/
 
 /* debug output */
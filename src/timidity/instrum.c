@@ -37,6 +37,100 @@ void free_instrument(Instrument *ip)
   SDL_free(ip);
 }
 
+/* Instruments only depend on the global configuration and the output
+   rate, so songs share them. Once loaded they are never modified, so
+   any number of songs can play from the same copy; the last song to
+   let go of one frees it. */
+typedef struct _CachedInstrument {
+  Instrument *ip;
+  Sint32 rate;
+  int dr, bank, program;
+  int refcount;
+  struct _CachedInstrument *next;
+} CachedInstrument;
+
+static CachedInstrument *instrument_cache = NULL;
+static SDL_Mutex *instrument_cache_lock = NULL;
+
+int init_instrument_cache(void)
+{
+  if (!instrument_cache_lock)
+    instrument_cache_lock = SDL_CreateMutex();
+  return instrument_cache_lock ? 0 : -1;
+}
+
+void end_instrument_cache(void)
+{
+  CachedInstrument *ci, *next;
+  for (ci = instrument_cache; ci; ci = next)
+    {
+      next = ci->next;
+      SNDDBG(("Instrument cache: %d references left to %s %d, program %d\n",
+	      ci->refcount, (ci->dr) ? "drum set" : "tone bank", ci->bank, ci->program));
+      free_instrument(ci->ip);
+      SDL_free(ci);
+    }
+  instrument_cache = NULL;
+  SDL_DestroyMutex(instrument_cache_lock);
+  instrument_cache_lock = NULL;
+}
+
+/* Caller must hold instrument_cache_lock. */
+static Instrument *find_cached_instrument(MidiSong *song, int dr, int b, int i)
+{
+  CachedInstrument *ci;
+  for (ci = instrument_cache; ci; ci = ci->next)
+    if (ci->rate == song->rate && ci->dr == dr && ci->bank == b && ci->program == i)
+      {
+	ci->refcount++;
+	return ci->ip;
+      }
+  return NULL;
+}
+
+/* Caller must hold instrument_cache_lock. If we can't cache it, the
+   song just doesn't get this instrument. */
+static Instrument *cache_instrument(MidiSong *song, int dr, int b, int i, Instrument *ip)
+{
+  CachedInstrument *ci = SDL_malloc(sizeof(CachedInstrument));
+  if (!ci)
+    {
+      free_instrument(ip);
+      song->oom = 1;
+      return NULL;
+    }
+  ci->ip = ip;
+  ci->rate = song->rate;
+  ci->dr = dr;
+  ci->bank = b;
+  ci->program = i;
+  ci->refcount = 1;
+  ci->next = instrument_cache;
+  instrument_cache = ci;
+  return ip;
+}
+
+/* Caller must hold instrument_cache_lock. */
+static void release_instrument(Instrument *ip)
+{
+  CachedInstrument *ci, *prev = NULL;
+  for (ci = instrument_cache; ci; prev = ci, ci = ci->next)
+    if (ci->ip == ip)
+      {
+	if (--ci->refcount == 0)
+	  {
+	    if (prev)
+	      prev->next = ci->next;
+	    else
+	      instrument_cache = ci->next;
+	    free_instrument(ci->ip);
+	    SDL_free(ci);
+	  }
+	return;
+      }
+  free_instrument(ip); /* not one of ours */
+}
+
 static void free_bank(MidiSong *song, int dr, int b)
 {
   int i;
@@ -45,7 +139,7 @@ static void free_bank(MidiSong *song, int dr, int b)
     if (bank->instrument[i])
       {
 	if (bank->instrument[i] != MAGIC_LOAD_INSTRUMENT)
-	  free_instrument(bank->instrument[i]);
+	  release_instrument(bank->instrument[i]);
 	bank->instrument[i] = NULL;
       }
 }
@@ -544,6 +638,8 @@ static int fill_bank(MidiSong *song, int dr, int b)
 	      bank->instrument[i] = NULL;
 	      errors++;
 	    }
+	  else if ((bank->instrument[i] = find_cached_instrument(song, dr, b, i)) != NULL)
+	    continue;
 	  else
 	    {
 	      /* preload soundfont */
@@ -551,8 +647,10 @@ static int fill_bank(MidiSong *song, int dr, int b)
 							(dr)? 128 : b,
 							(dr)? b : i,
 							(dr)? i : -1);
-	      if (bank->instrument[i])
+	      if (bank->instrument[i]) {
+		  bank->instrument[i] = cache_instrument(song, dr, b, i, bank->instrument[i]);
 		  continue;
+	      }
 	      /* try gus patch */
 	      load_instrument(song,
 				     bank->tone[i].name,
@@ -570,8 +668,10 @@ static int fill_bank(MidiSong *song, int dr, int b)
 				     bank->tone[i].strip_envelope :
 				     ((dr) ? 1 : -1),
 				     bank->tone[i].strip_tail);
-	      if (bank->instrument[i])
+	      if (bank->instrument[i]) {
+		  bank->instrument[i] = cache_instrument(song, dr, b, i, bank->instrument[i]);
 		  continue;
+	      }
 	      /* no patch; search soundfont again. */
 	      bank->instrument[i] = load_soundfont(song, 1,
 							(dr)? 128 : b,
@@ -582,7 +682,8 @@ static int fill_bank(MidiSong *song, int dr, int b)
 		   bank->tone[i].name,
 		   (dr)? "drum set" : "tone bank", b, i));
 		errors++;
-	      }
+	      } else
+		bank->instrument[i] = cache_instrument(song, dr, b, i, bank->instrument[i]);
 	    }
 	}
     }
@@ -592,6 +693,7 @@ static int fill_bank(MidiSong *song, int dr, int b)
 int load_missing_instruments(MidiSong *song)
 {
   int i=MAXBANK,errors=0;
+  SDL_LockMutex(instrument_cache_lock);
   while (i--)
     {
       if (song->tonebank[i])
@@ -599,12 +701,14 @@ int load_missing_instruments(MidiSong *song)
       if (song->drumset[i])
 	errors+=fill_bank(song,1,i);
     }
+  SDL_UnlockMutex(instrument_cache_lock);
   return errors;
 }
 
 void free_instruments(MidiSong *song)
 {
   int i=MAXBANK;
+  SDL_LockMutex(instrument_cache_lock);
   while(i--)
     {
       if (song->tonebank[i])
@@ -612,6 +716,7 @@ void free_instruments(MidiSong *song)
       if (song->drumset[i])
 	free_bank(song, 1, i);
     }
+  SDL_UnlockMutex(instrument_cache_lock);
 }
 
 int set_default_instrument(MidiSong *song, const char *name)
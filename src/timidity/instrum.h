@@ -30,10 +30,14 @@
 #define free_instruments TIMI_NAMESPACE(free_instruments)
 #define set_default_instrument TIMI_NAMESPACE(set_default_instrument)
 #define free_instrument  TIMI_NAMESPACE(free_instrument)
+#define init_instrument_cache TIMI_NAMESPACE(init_instrument_cache)
+#define end_instrument_cache TIMI_NAMESPACE(end_instrument_cache)
 
 extern int load_missing_instruments(MidiSong *song);
 extern void free_instruments(MidiSong *song);
 extern void free_instrument(Instrument *inst);
 extern int set_default_instrument(MidiSong *song, const char *name);
+extern int init_instrument_cache(void);
+extern void end_instrument_cache(void);
 
 #endif /* TIMIDITY_INSTRUM_H */
@@ -8,6 +8,7 @@
     mix.c */
 
 #include <SDL3/SDL.h>
+#include <SDL3/SDL_intrin.h>
 
 #include "timidity.h"
 #include "options.h"
@@ -168,6 +169,249 @@ static int update_signal(MidiSong *song, int v)
 
 #define MIXATION(a)	*lp++ += (a)*s;
 
+/* The spans below are where nearly all of the mixing time goes, so they
+   have SIMD versions. Samples are 16 bits and amplitudes never exceed
+   MAX_AMP_VALUE, so every product fits exactly in 32 bits and the SIMD
+   results are bit-identical to the scalar loops. An amplitude that
+   doesn't fit in 16 bits (it shouldn't happen) takes the scalar path. */
+
+#define AMP_FITS_16BIT(a) ((a) >= -32768 && (a) <= 32767)
+
+#ifdef SDL_SSE2_INTRINSICS
+/* 8 samples times amp as 2 vectors of 4 Sint32 products. */
+#define SSE2_MUL8(sv, ampv, p0, p1) do { \
+    const __m128i lo_ = _mm_mullo_epi16(sv, ampv); \
+    const __m128i hi_ = _mm_mulhi_epi16(sv, ampv); \
+    p0 = _mm_unpacklo_epi16(lo_, hi_); \
+    p1 = _mm_unpackhi_epi16(lo_, hi_); \
+  } while (0)
+
+#define SSE2_ACCUM(ptr, v) \
+    _mm_storeu_si128((__m128i *)(ptr), _mm_add_epi32(_mm_loadu_si128((const __m128i *)(ptr)), v))
+
+static int SDL_TARGETING("sse2") mix_span_mono_sse2(const sample_t *sp, Sint32 *lp, Sint32 amp, int count)
+{
+  const __m128i ampv = _mm_set1_epi16((Sint16)amp);
+  int i;
+  for (i = 0; i + 8 <= count; i += 8)
+    {
+      const __m128i sv = _mm_loadu_si128((const __m128i *)(sp + i));
+      __m128i p0, p1;
+      SSE2_MUL8(sv, ampv, p0, p1);
+      SSE2_ACCUM(lp + i, p0);
+      SSE2_ACCUM(lp + i + 4, p1);
+    }
+  return i;
+}
+
+static int SDL_TARGETING("sse2") mix_span_center_sse2(const sample_t *sp, Sint32 *lp, Sint32 amp, int count)
+{
+  const __m128i ampv = _mm_set1_epi16((Sint16)amp);
+  int i;
+  for (i = 0; i + 8 <= count; i += 8)
+    {
+      const __m128i sv = _mm_loadu_si128((const __m128i *)(sp + i));
+      Sint32 *out = lp + i * 2;
+      __m128i p0, p1;
+      SSE2_MUL8(sv, ampv, p0, p1);
+      SSE2_ACCUM(out, _mm_unpacklo_epi32(p0, p0));
+      SSE2_ACCUM(out + 4, _mm_unpackhi_epi32(p0, p0));
+      SSE2_ACCUM(out + 8, _mm_unpacklo_epi32(p1, p1));
+      SSE2_ACCUM(out + 12, _mm_unpackhi_epi32(p1, p1));
+    }
+  return i;
+}
+
+static int SDL_TARGETING("sse2") mix_span_single_sse2(const sample_t *sp, Sint32 *lp, Sint32 amp, int count)
+{
+  const __m128i ampv = _mm_set1_epi16((Sint16)amp);
+  const __m128i zero = _mm_setzero_si128();
+  int i;
+  for (i = 0; i + 8 <= count; i += 8)
+    {
+      const __m128i sv = _mm_loadu_si128((const __m128i *)(sp + i));
+      Sint32 *out = lp + i * 2;
+      __m128i p0, p1;
+      SSE2_MUL8(sv, ampv, p0, p1);
+      SSE2_ACCUM(out, _mm_unpacklo_epi32(p0, zero));
+      SSE2_ACCUM(out + 4, _mm_unpackhi_epi32(p0, zero));
+      SSE2_ACCUM(out + 8, _mm_unpacklo_epi32(p1, zero));
+      SSE2_ACCUM(out + 12, _mm_unpackhi_epi32(p1, zero));
+    }
+  return i;
+}
+
+static int SDL_TARGETING("sse2") mix_span_mystery_sse2(const sample_t *sp, Sint32 *lp, Sint32 left, Sint32 right, int count)
+{
+  const __m128i ampv = _mm_set_epi16((Sint16)right, (Sint16)left, (Sint16)right, (Sint16)left,
+				     (Sint16)right, (Sint16)left, (Sint16)right, (Sint16)left);
+  int i;
+  for (i = 0; i + 8 <= count; i += 8)
+    {
+      const __m128i sv = _mm_loadu_si128((const __m128i *)(sp + i));
+      Sint32 *out = lp + i * 2;
+      __m128i p0, p1;
+      SSE2_MUL8(_mm_unpacklo_epi16(sv, sv), ampv, p0, p1);
+      SSE2_ACCUM(out, p0);
+      SSE2_ACCUM(out + 4, p1);
+      SSE2_MUL8(_mm_unpackhi_epi16(sv, sv), ampv, p0, p1);
+      SSE2_ACCUM(out + 8, p0);
+      SSE2_ACCUM(out + 12, p1);
+    }
+  return i;
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+static int mix_span_mono_neon(const sample_t *sp, Sint32 *lp, Sint32 amp, int count)
+{
+  int i;
+  for (i = 0; i + 4 <= count; i += 4)
+    vst1q_s32(lp + i, vmlal_n_s16(vld1q_s32(lp + i), vld1_s16(sp + i), (int16_t)amp));
+  return i;
+}
+
+static int mix_span_center_neon(const sample_t *sp, Sint32 *lp, Sint32 amp, int count)
+{
+  int i;
+  for (i = 0; i + 4 <= count; i += 4)
+    {
+      const int32x4_t p = vmull_n_s16(vld1_s16(sp + i), (int16_t)amp);
+      int32x4x2_t lr = vld2q_s32(lp + i * 2);  /* deinterleaves left/right */
+      lr.val[0] = vaddq_s32(lr.val[0], p);
+      lr.val[1] = vaddq_s32(lr.val[1], p);
+      vst2q_s32(lp + i * 2, lr);
+    }
+  return i;
+}
+
+static int mix_span_single_neon(const sample_t *sp, Sint32 *lp, Sint32 amp, int count)
+{
+  int i;
+  for (i = 0; i + 4 <= count; i += 4)
+    {
+      int32x4x2_t lr = vld2q_s32(lp + i * 2);
+      lr.val[0] = vmlal_n_s16(lr.val[0], vld1_s16(sp + i), (int16_t)amp);
+      vst2q_s32(lp + i * 2, lr);
+    }
+  return i;
+}
+
+static int mix_span_mystery_neon(const sample_t *sp, Sint32 *lp, Sint32 left, Sint32 right, int count)
+{
+  int i;
+  for (i = 0; i + 4 <= count; i += 4)
+    {
+      const int16x4_t sv = vld1_s16(sp + i);
+      int32x4x2_t lr = vld2q_s32(lp + i * 2);
+      lr.val[0] = vmlal_n_s16(lr.val[0], sv, (int16_t)left);
+      lr.val[1] = vmlal_n_s16(lr.val[1], sv, (int16_t)right);
+      vst2q_s32(lp + i * 2, lr);
+    }
+  return i;
+}
+#endif
+
+/* Mix count samples into a mono buffer. */
+static void mix_span_mono(const sample_t *sp, Sint32 *lp, Sint32 amp, int count)
+{
+  int i = 0;
+  sample_t s;
+  if (AMP_FITS_16BIT(amp))
+    {
+#if defined(SDL_SSE2_INTRINSICS)
+      if (timi_has_sse2)
+	i = mix_span_mono_sse2(sp, lp, amp, count);
+#elif defined(SDL_NEON_INTRINSICS)
+      if (timi_has_neon)
+	i = mix_span_mono_neon(sp, lp, amp, count);
+#endif
+    }
+  sp += i;
+  lp += i;
+  for (; i < count; i++)
+    {
+      s = *sp++;
+      MIXATION(amp);
+    }
+}
+
+/* Mix count samples into both channels of a stereo buffer. */
+static void mix_span_center(const sample_t *sp, Sint32 *lp, Sint32 amp, int count)
+{
+  int i = 0;
+  sample_t s;
+  if (AMP_FITS_16BIT(amp))
+    {
+#if defined(SDL_SSE2_INTRINSICS)
+      if (timi_has_sse2)
+	i = mix_span_center_sse2(sp, lp, amp, count);
+#elif defined(SDL_NEON_INTRINSICS)
+      if (timi_has_neon)
+	i = mix_span_center_neon(sp, lp, amp, count);
+#endif
+    }
+  sp += i;
+  lp += i * 2;
+  for (; i < count; i++)
+    {
+      s = *sp++;
+      MIXATION(amp);
+      MIXATION(amp);
+    }
+}
+
+/* Mix count samples into one channel of a stereo buffer; lp points at
+   the first sample of that channel. */
+static void mix_span_single(const sample_t *sp, Sint32 *lp, Sint32 amp, int count)
+{
+  int i = 0;
+  sample_t s;
+  if (AMP_FITS_16BIT(amp))
+    {
+#if defined(SDL_SSE2_INTRINSICS)
+      if (timi_has_sse2)
+	i = mix_span_single_sse2(sp, lp, amp, count);
+#elif defined(SDL_NEON_INTRINSICS)
+      if (timi_has_neon)
+	i = mix_span_single_neon(sp, lp, amp, count);
+#endif
+    }
+  sp += i;
+  lp += i * 2;
+  for (; i < count; i++)
+    {
+      s = *sp++;
+      MIXATION(amp);
+      lp++;
+    }
+}
+
+/* Mix count samples into a stereo buffer at separate left/right volumes. */
+static void mix_span_mystery(const sample_t *sp, Sint32 *lp, Sint32 left, Sint32 right, int count)
+{
+  int i = 0;
+  sample_t s;
+  if (AMP_FITS_16BIT(left) && AMP_FITS_16BIT(right))
+    {
+#if defined(SDL_SSE2_INTRINSICS)
+      if (timi_has_sse2)
+	i = mix_span_mystery_sse2(sp, lp, left, right, count);
+#elif defined(SDL_NEON_INTRINSICS)
+      if (timi_has_neon)
+	i = mix_span_mystery_neon(sp, lp, left, right, count);
+#endif
+    }
+  sp += i;
+  lp += i * 2;
+  for (; i < count; i++)
+    {
+      s = *sp++;
+      MIXATION(left);
+      MIXATION(right);
+    }
+}
+
 static void mix_mystery_signal(MidiSong *song, sample_t *sp, Sint32 *lp, int v,
 			       int count)
 {
@@ -176,7 +420,6 @@ static void mix_mystery_signal(MidiSong *song, sample_t *sp, Sint32 *lp, int v,
     left=vp->left_mix, 
     right=vp->right_mix;
   int cc;
-  sample_t s;
 
   if (!(cc = vp->control_counter))
     {
@@ -191,12 +434,9 @@ static void mix_mystery_signal(MidiSong *song, sample_t *sp, Sint32 *lp, int v,
     if (cc < count)
       {
 	count -= cc;
-	while (cc--)
-	  {
-	    s = *sp++;
-	    MIXATION(left);
-	    MIXATION(right);
-	  }
+	mix_span_mystery(sp, lp, left, right, cc);
+	sp += cc;
+	lp += cc * 2;
 	cc = song->control_ratio;
 	if (update_signal(song, v))
 	  return;	/* Envelope ran out */
@@ -206,12 +446,7 @@ static void mix_mystery_signal(MidiSong *song, sample_t *sp, Sint32 *lp, int v,
     else
       {
 	vp->control_counter = cc - count;
-	while (count--)
-	  {
-	    s = *sp++;
-	    MIXATION(left);
-	    MIXATION(right);
-	  }
+	mix_span_mystery(sp, lp, left, right, count);
 	return;
       }
 }
@@ -223,7 +458,6 @@ static void mix_center_signal(MidiSong *song, sample_t *sp, Sint32 *lp, int v,
   final_volume_t 
     left=vp->left_mix;
   int cc;
-  sample_t s;
 
   if (!(cc = vp->control_counter))
     {
@@ -237,12 +471,9 @@ static void mix_center_signal(MidiSong *song, sample_t *sp, Sint32 *lp, int v,
     if (cc < count)
       {
 	count -= cc;
-	while (cc--)
-	  {
-	    s = *sp++;
-	    MIXATION(left);
-	    MIXATION(left);
-	  }
+	mix_span_center(sp, lp, left, cc);
+	sp += cc;
+	lp += cc * 2;
 	cc = song->control_ratio;
 	if (update_signal(song, v))
 	  return;	/* Envelope ran out */
@@ -251,12 +482,7 @@ static void mix_center_signal(MidiSong *song, sample_t *sp, Sint32 *lp, int v,
     else
       {
 	vp->control_counter = cc - count;
-	while (count--)
-	  {
-	    s = *sp++;
-	    MIXATION(left);
-	    MIXATION(left);
-	  }
+	mix_span_center(sp, lp, left, count);
 	return;
       }
 }
@@ -268,7 +494,6 @@ static void mix_single_signal(MidiSong *song, sample_t *sp, Sint32 *lp, int v,
   final_volume_t 
     left=vp->left_mix;
   int cc;
-  sample_t s;
 
   if (!(cc = vp->control_counter))
     {
@@ -282,12 +507,9 @@ static void mix_single_signal(MidiSong *song, sample_t *sp, Sint32 *lp, int v,
     if (cc < count)
       {
 	count -= cc;
-	while (cc--)
-	  {
-	    s = *sp++;
-	    MIXATION(left);
-	    lp++;
-	  }
+	mix_span_single(sp, lp, left, cc);
+	sp += cc;
+	lp += cc * 2;
 	cc = song->control_ratio;
 	if (update_signal(song, v))
 	  return;	/* Envelope ran out */
@@ -296,12 +518,7 @@ static void mix_single_signal(MidiSong *song, sample_t *sp, Sint32 *lp, int v,
     else
       {
 	vp->control_counter = cc - count;
-	while (count--)
-	  {
-	    s = *sp++;
-	    MIXATION(left);
-	    lp++;
-	  }
+	mix_span_single(sp, lp, left, count);
 	return;
       }
 }
@@ -313,7 +530,6 @@ static void mix_mono_signal(MidiSong *song, sample_t *sp, Sint32 *lp, int v,
   final_volume_t 
     left=vp->left_mix;
   int cc;
-  sample_t s;
 
   if (!(cc = vp->control_counter))
     {
@@ -327,11 +543,9 @@ static void mix_mono_signal(MidiSong *song, sample_t *sp, Sint32 *lp, int v,
     if (cc < count)
       {
 	count -= cc;
-	while (cc--)
-	  {
-	    s = *sp++;
-	    MIXATION(left);
-	  }
+	mix_span_mono(sp, lp, left, cc);
+	sp += cc;
+	lp += cc;
 	cc = song->control_ratio;
 	if (update_signal(song, v))
 	  return;	/* Envelope ran out */
@@ -340,69 +554,29 @@ static void mix_mono_signal(MidiSong *song, sample_t *sp, Sint32 *lp, int v,
     else
       {
 	vp->control_counter = cc - count;
-	while (count--)
-	  {
-	    s = *sp++;
-	    MIXATION(left);
-	  }
+	mix_span_mono(sp, lp, left, count);
 	return;
       }
 }
 
 static void mix_mystery(MidiSong *song, sample_t *sp, Sint32 *lp, int v, int count)
 {
-  final_volume_t 
-    left = song->voice[v].left_mix, 
-    right = song->voice[v].right_mix;
-  sample_t s;
-
-  while (count--)
-    {
-      s = *sp++;
-      MIXATION(left);
-      MIXATION(right);
-    }
+  mix_span_mystery(sp, lp, song->voice[v].left_mix, song->voice[v].right_mix, count);
 }
 
 static void mix_center(MidiSong *song, sample_t *sp, Sint32 *lp, int v, int count)
 {
-  final_volume_t 
-    left = song->voice[v].left_mix;
-  sample_t s;
-
-  while (count--)
-    {
-      s = *sp++;
-      MIXATION(left);
-      MIXATION(left);
-    }
+  mix_span_center(sp, lp, song->voice[v].left_mix, count);
 }
 
 static void mix_single(MidiSong *song, sample_t *sp, Sint32 *lp, int v, int count)
 {
-  final_volume_t 
-    left = song->voice[v].left_mix;
-  sample_t s;
-
-  while (count--)
-    {
-      s = *sp++;
-      MIXATION(left);
-      lp++;
-    }
+  mix_span_single(sp, lp, song->voice[v].left_mix, count);
 }
 
 static void mix_mono(MidiSong *song, sample_t *sp, Sint32 *lp, int v, int count)
 {
-  final_volume_t 
-    left = song->voice[v].left_mix;
-  sample_t s;
-
-  while (count--)
-    {
-      s = *sp++;
-      MIXATION(left);
-    }
+  mix_span_mono(sp, lp, song->voice[v].left_mix, count);
 }
 
 /* Ramp a note out in c samples */
@@ -492,7 +666,8 @@ static void ramp_out(MidiSong *song, sample_t *sp, Sint32 *lp, int v, Sint32 c)
 
 /**************** interface function ******************/
 
-void mix_voice(MidiSong *song, Sint32 *buf, int v, Sint32 c)
+/* resample_buf must hold at least c samples. */
+void mix_voice(MidiSong *song, Sint32 *buf, sample_t *resample_buf, int v, Sint32 c)
 {
   Voice *vp = song->voice + v;
   sample_t *sp;
@@ -500,14 +675,14 @@ void mix_voice(MidiSong *song, Sint32 *buf, int v, Sint32 c)
     {
       if (c>=MAX_DIE_TIME)
 	c=MAX_DIE_TIME;
-      sp=resample_voice(song, v, &c);
+      sp=resample_voice(song, v, &c, resample_buf);
       if(c > 0)
 	ramp_out(song, sp, buf, v, c);
       vp->status=VOICE_FREE;
     }
   else
     {
-      sp=resample_voice(song, v, &c);
+      sp=resample_voice(song, v, &c, resample_buf);
       if (song->encoding & PE_MONO)
 	{
 	  /* Mono output. */
@@ -61,6 +61,11 @@
    click removal. */
 #define MAX_DIE_TIME 20
 
+/* Seconds of song time between the channel state snapshots kept for
+   seeking. A seek only has to replay the events after the closest
+   snapshot instead of everything from the start of the song. */
+#define SEEK_POINT_SECONDS 5
+
 /**************************************************************************/
 /* Anything below this shouldn't need to be changed unless you're porting
    to a new machine with other than 32-bit, big-endian words. */
@@ -488,14 +488,52 @@ static void adjust_volume(MidiSong *song)
       }
 }
 
-static void seek_forward(MidiSong *song, Sint32 until_time)
+/* Keep song->held_notes up to date while replaying events without
+   playing them. */
+static void hold_note(MidiSong *song)
 {
-  reset_voices(song);
+  MidiEvent *e = song->current_event;
+  song->held_notes[e->channel][e->a] = (Sint32)(e - song->events) + 1;
+}
+
+static void release_note(MidiSong *song, int c, int note)
+{
+  Sint32 *held = &song->held_notes[c][note];
+  if (*held > 0)
+    *held = song->channel[c].sustain ? -*held : 0;
+}
+
+static void release_sustained_notes(MidiSong *song, int c)
+{
+  int i;
+  for (i = 0; i < 128; i++)
+    if (song->held_notes[c][i] < 0)
+      song->held_notes[c][i] = 0;
+}
+
+/* Apply the parameter changes of all events before until_time to the
+   channels, and track which notes are held, without playing anything.
+   Returns 0 if the end of the track was reached first. */
+static int replay_controls(MidiSong *song, Sint32 until_time)
+{
+  int i;
+
   while (song->current_event->time < until_time)
     {
       switch(song->current_event->type)
 	{
-	  /* All notes stay off. Just handle the parameter changes. */
+	case ME_NOTEON:
+	  if (!(song->current_event->b)) /* Velocity 0? */
+	    release_note(song, song->current_event->channel,
+			 song->current_event->a);
+	  else
+	    hold_note(song);
+	  break;
+
+	case ME_NOTEOFF:
+	  release_note(song, song->current_event->channel,
+		       song->current_event->a);
+	  break;
 
 	case ME_PITCH_SENS:
 	  song->channel[song->current_event->channel].pitchsens =
@@ -537,89 +575,385 @@ static void seek_forward(MidiSong *song, Sint32 until_time)
 	case ME_SUSTAIN:
 	  song->channel[song->current_event->channel].sustain =
 	    song->current_event->a;
+	  if (!song->current_event->a)
+	    release_sustained_notes(song, song->current_event->channel);
 	  break;
 
 	case ME_RESET_CONTROLLERS:
 	  reset_controllers(song, song->current_event->channel);
 	  break;
 
+	case ME_ALL_NOTES_OFF:
+	  for (i = 0; i < 128; i++)
+	    release_note(song, song->current_event->channel, i);
+	  break;
+
+	case ME_ALL_SOUNDS_OFF:
+	  SDL_memset(song->held_notes[song->current_event->channel], 0,
+		     sizeof(song->held_notes[0]));
+	  break;
+
 	case ME_TONE_BANK:
 	  song->channel[song->current_event->channel].bank =
 	    song->current_event->a;
 	  break;
 
 	case ME_EOT:
-	  song->current_sample = song->current_event->time;
-	  return;
+	  return 0;
 	}
       song->current_event++;
     }
-  /*song->current_sample=song->current_event->time;*/
-  if (song->current_event != song->events)
-    song->current_event--;
+  return 1;
+}
+
+/* Move a freshly started voice `elapsed` samples into its note, as if
+   it had been playing all along. Vibrato is ignored, and the envelope
+   still ramps up from the start so we don't click. Returns 0 if the
+   sample would already have run out. */
+static int advance_voice(MidiSong *song, int v, Sint32 elapsed)
+{
+  Voice *vp = &song->voice[v];
+  Sample *sp = vp->sample;
+  Sint64 ofs = (Sint64)vp->sample_increment * elapsed;
+  Sint64 loop_length = sp->loop_end - sp->loop_start;
+
+  if ((sp->modes & MODES_LOOPING) && loop_length > 0 && ofs >= sp->loop_end)
+    {
+      if (sp->modes & MODES_PINGPONG)
+	{
+	  ofs = (ofs - sp->loop_start) % (2 * loop_length);
+	  if (ofs < loop_length)
+	    ofs += sp->loop_start;
+	  else
+	    {
+	      /* On the way back down the loop */
+	      ofs = sp->loop_end - (ofs - loop_length);
+	      vp->sample_increment = -vp->sample_increment;
+	    }
+	}
+      else
+	ofs = sp->loop_start + (ofs - sp->loop_start) % loop_length;
+    }
+  else if (ofs >= sp->data_length)
+    return 0;
+
+  vp->sample_offset = (Sint32)ofs;
+  return 1;
+}
+
+/* Start the notes that are held at the current position partway
+   through, instead of leaving silence until the next Note On. */
+static void restart_held_notes(MidiSong *song)
+{
+  int c, n, i, nv;
+  int vlist[32];
+
+  for (c = 0; c < MAXCHAN; c++)
+    for (n = 0; n < 128; n++)
+      {
+	Sint32 held = song->held_notes[c][n];
+	MidiEvent *e;
+
+	if (!held)
+	  continue;
+	e = &song->events[(held > 0 ? held : -held) - 1];
+	nv = find_samples(song, e, vlist);
+	for (i = 0; i < nv; i++)
+	  {
+	    start_note(song, e, vlist[i]);
+	    if (!advance_voice(song, vlist[i], song->current_sample - e->time))
+	      song->voice[vlist[i]].status = VOICE_FREE;
+	    else if (held < 0)
+	      song->voice[vlist[i]].status = VOICE_SUSTAINED;
+	  }
+      }
+}
+
+static void seek_forward(MidiSong *song, Sint32 until_time)
+{
+  reset_voices(song);
+  if (!replay_controls(song, until_time))
+    {
+      song->current_sample = song->current_event->time;
+      return;
+    }
   song->current_sample=until_time;
+  restart_held_notes(song);
+}
+
+/* Walk the event list once and remember the channel state and held
+   notes every SEEK_POINT_SECONDS, so skip_to() can start from there
+   without replaying the whole song. Returns NULL if the song is too
+   short for that or we run out of memory; then we just seek the slow
+   way. This leaves the song's playback state scrambled. */
+MidiSeekIndex *build_seek_index(MidiSong *song)
+{
+  Sint32 interval = song->rate * SEEK_POINT_SECONDS;
+  Sint32 length = song->events[song->groomed_event_count - 1].time;
+  Sint32 count = length / interval;
+  Sint32 notes_allocated = 0, note_count = 0;
+  MidiSeekIndex *index;
+  Sint32 i;
+  int c, n;
+
+  if (count <= 0)
+    return NULL;
+
+  index = SDL_calloc(1, sizeof(MidiSeekIndex));
+  if (!index)
+    return NULL;
+  index->points = SDL_malloc(count * sizeof(MidiSeekPoint));
+  if (!index->points)
+    {
+      SDL_free(index);
+      return NULL;
+    }
+
+  reset_midi(song);
+  SDL_memset(song->held_notes, 0, sizeof(song->held_notes));
+  song->current_event = song->events;
+  for (i = 0; i < count; i++)
+    {
+      MidiSeekPoint *point = &index->points[i];
+      point->time = (i + 1) * interval;
+      if (!replay_controls(song, point->time))
+	break;
+      point->event_index = (Sint32)(song->current_event - song->events);
+      SDL_memcpy(point->channel, song->channel, sizeof(song->channel));
+      point->note_index = note_count;
+      for (c = 0; c < MAXCHAN; c++)
+	for (n = 0; n < 128; n++)
+	  {
+	    if (!song->held_notes[c][n])
+	      continue;
+	    if (note_count == notes_allocated)
+	      {
+		Sint32 *notes;
+		notes_allocated = notes_allocated ? notes_allocated * 2 : 256;
+		notes = SDL_realloc(index->notes, notes_allocated * sizeof(Sint32));
+		if (!notes)
+		  {
+		    Timidity_FreeSeekIndex(index);
+		    return NULL;
+		  }
+		index->notes = notes;
+	      }
+	    index->notes[note_count++] = song->held_notes[c][n];
+	  }
+      point->note_count = note_count - point->note_index;
+    }
+  index->point_count = i;
+  return index;
+}
+
+static const MidiSeekPoint *find_seek_point(MidiSong *song, Sint32 until_time)
+{
+  const MidiSeekIndex *index = song->seek_index;
+  Sint32 i;
+
+  if (!index || !index->point_count)
+    return NULL;
+  i = until_time / (song->rate * SEEK_POINT_SECONDS) - 1;
+  if (i < 0)
+    return NULL;
+  if (i >= index->point_count)
+    i = index->point_count - 1;
+  return &index->points[i];
 }
 
-static void skip_to(MidiSong *song, Sint32 until_time)
+/* Returns 0 if until_time is past the end of the song. */
+static int skip_to(MidiSong *song, Sint32 until_time)
 {
+  const MidiSeekPoint *point = find_seek_point(song, until_time);
+  Sint32 i;
+
   if (song->current_sample > until_time)
     song->current_sample = 0;
 
   reset_midi(song);
-  song->buffered_count = 0;
-  song->buffer_pointer = song->common_buffer;
+  SDL_memset(song->held_notes, 0, sizeof(song->held_notes));
   song->current_event = song->events;
 
+  if (point)
+    {
+      SDL_memcpy(song->channel, point->channel, sizeof(song->channel));
+      song->current_event = song->events + point->event_index;
+      for (i = 0; i < point->note_count; i++)
+	{
+	  Sint32 held = song->seek_index->notes[point->note_index + i];
+	  MidiEvent *e = &song->events[(held > 0 ? held : -held) - 1];
+	  song->held_notes[e->channel][e->a] = held;
+	}
+    }
+
   if (until_time)
     seek_forward(song, until_time);
+
+  return until_time <= song->events[song->groomed_event_count - 1].time;
 }
 
-static void do_compute_data(MidiSong *song, Sint32 count)
+/* Don't wake up the helper threads unless there is at least this much
+   work (active voices times samples) to share. */
+#define MIN_THREADED_VOICE_SAMPLES 4096
+
+static void mix_voice_range(MidiSong *song, Sint32 *buf, sample_t *resample_buf,
+			    int first, int end, Sint32 count)
 {
   int i;
-  SDL_memset(song->buffer_pointer, 0, 
-	 (song->encoding & PE_MONO) ? (count * 4) : (count * 8));
+  for (i = first; i < end; i++)
+    mix_voice(song, buf, resample_buf, song->active_voices[i], count);
+}
+
+static int SDLCALL voice_worker(void *data)
+{
+  MidiWorker *w = (MidiWorker *) data;
+  MidiSong *song = w->song;
+  int samples;
+
+  for (;;)
+    {
+      SDL_WaitSemaphore(w->start);
+      if (song->workers_quit)
+	break;
+      samples = (song->encoding & PE_MONO) ? w->count : (w->count * 2);
+      SDL_memset(w->mix_buffer, 0, samples * sizeof(Sint32));
+      mix_voice_range(song, w->mix_buffer, w->resample_buffer,
+		      w->first_voice, w->end_voice, w->count);
+      SDL_SignalSemaphore(song->workers_done);
+    }
+  return 0;
+}
+
+static void do_compute_data(MidiSong *song, Sint32 *buf, Sint32 count)
+{
+  int i, j, active = 0;
+  int samples = (song->encoding & PE_MONO) ? count : (count * 2);
+
+  SDL_memset(buf, 0, samples * sizeof(Sint32));
   for (i = 0; i < song->voices; i++)
     {
       if(song->voice[i].status != VOICE_FREE)
-	mix_voice(song, song->buffer_pointer, i, count);
+	song->active_voices[active++] = i;
     }
+
+  if (song->worker_count && active > 1 && active * count >= MIN_THREADED_VOICE_SAMPLES)
+    {
+      /* Split the active voices into contiguous, equal-ish ranges, one
+	 per thread. Every voice only touches its own state, and integer
+	 sums don't care about order, so this matches the serial mix. */
+      int threads = song->worker_count + 1;
+      int workers;
+      if (threads > active)
+	threads = active;
+      workers = threads - 1;
+      for (j = 0; j < workers; j++)
+	{
+	  MidiWorker *w = &song->workers[j];
+	  w->first_voice = (active * (j + 1)) / threads;
+	  w->end_voice = (active * (j + 2)) / threads;
+	  w->count = count;
+	  SDL_SignalSemaphore(w->start);
+	}
+      mix_voice_range(song, buf, song->resample_buffer, 0, active / threads, count);
+      for (j = 0; j < workers; j++)
+	SDL_WaitSemaphore(song->workers_done);
+      for (j = 0; j < workers; j++)
+	{
+	  const Sint32 *src = song->workers[j].mix_buffer;
+	  for (i = 0; i < samples; i++)
+	    buf[i] += src[i];
+	}
+    }
+  else
+    mix_voice_range(song, buf, song->resample_buffer, 0, active, count);
+
   song->current_sample += count;
 }
 
-/* count=0 means flush remaining buffered data to output device, then
-   flush the device itself */
-static void compute_data(MidiSong *song, void *stream, Sint32 count)
+int Timidity_SetThreads(MidiSong *song, int threads)
 {
-  int channels;
-
-  if ( song->encoding & PE_MONO )
-    channels = 1;
-  else
-    channels = 2;
+  int i;
 
-  if (!count)
+  /* Tear down whatever we had first. */
+  if (song->workers)
     {
-      if (song->buffered_count)
-          song->write(stream, song->common_buffer, channels * song->buffered_count);
-      song->buffer_pointer = song->common_buffer;
-      song->buffered_count = 0;
-      return;
+      song->workers_quit = 1;
+      for (i = 0; i < song->worker_count; i++)
+	SDL_SignalSemaphore(song->workers[i].start);
+      for (i = 0; i < song->worker_count; i++)
+	{
+	  SDL_WaitThread(song->workers[i].thread, NULL);
+	  SDL_DestroySemaphore(song->workers[i].start);
+	  SDL_free(song->workers[i].mix_buffer);
+	  SDL_free(song->workers[i].resample_buffer);
+	}
+      SDL_free(song->workers);
+      song->workers = NULL;
+      song->worker_count = 0;
+      song->workers_quit = 0;
     }
+  if (song->workers_done)
+    {
+      SDL_DestroySemaphore(song->workers_done);
+      song->workers_done = NULL;
+    }
+
+  if (threads <= 1)
+    return 0;
+  if (threads > MAX_VOICES)
+    threads = MAX_VOICES;
+
+  song->workers_done = SDL_CreateSemaphore(0);
+  song->workers = SDL_calloc(threads - 1, sizeof(MidiWorker));
+  if (!song->workers_done || !song->workers)
+    goto fail;
 
-  while ((count + song->buffered_count) >= song->buffer_size)
+  for (i = 0; i < threads - 1; i++)
     {
-      do_compute_data(song, song->buffer_size - song->buffered_count);
-      count -= song->buffer_size - song->buffered_count;
-      song->write(stream, song->common_buffer, channels * song->buffer_size);
-      song->buffer_pointer = song->common_buffer;
-      song->buffered_count = 0;
+      MidiWorker *w = &song->workers[i];
+      w->song = song;
+      w->mix_buffer = SDL_malloc(song->buffer_size * 2 * sizeof(Sint32));
+      w->resample_buffer = SDL_malloc(song->buffer_size * sizeof(sample_t));
+      w->start = SDL_CreateSemaphore(0);
+      if (w->mix_buffer && w->resample_buffer && w->start)
+	w->thread = SDL_CreateThread(voice_worker, "timidity voices", w);
+      if (!w->thread)
+	{
+	  SDL_free(w->mix_buffer);
+	  SDL_free(w->resample_buffer);
+	  SDL_DestroySemaphore(w->start);
+	  break;
+	}
+      song->worker_count++;
     }
-  if (count>0)
+  if (song->worker_count == threads - 1)
+    return 0;
+
+fail:
+  Timidity_SetThreads(song, 1);
+  return -1;
+}
+
+/* Render count samples to *stream and advance it past them. When the
+   output samples are 32 bits wide we mix right in the destination and
+   convert it in place, otherwise we mix in common_buffer first. Either
+   way, at most buffer_size samples are mixed at once, since that's what
+   resample_buffer holds. */
+static void compute_data(MidiSong *song, Uint8 **stream, Sint32 count, int bytes_per_sample)
+{
+  int channels = (song->encoding & PE_MONO) ? 1 : 2;
+  int in_place = (bytes_per_sample == channels * (int)sizeof(Sint32));
+
+  while (count > 0)
     {
-      do_compute_data(song, count);
-      song->buffered_count += count;
-      song->buffer_pointer += (song->encoding & PE_MONO) ? count : count*2;
+      Sint32 n = (count < song->buffer_size) ? count : song->buffer_size;
+      Sint32 *buf = song->common_buffer;
+      if (in_place && ((uintptr_t)*stream % sizeof(Sint32)) == 0)
+	buf = (Sint32 *)*stream;
+      do_compute_data(song, buf, n);
+      song->write(*stream, buf, channels * n);
+      *stream += n * bytes_per_sample;
+      count -= n;
     }
 }
 
@@ -640,9 +974,54 @@ int Timidity_IsActive(MidiSong *song)
   return song->playing;
 }
 
-void Timidity_Seek(MidiSong *song, Uint32 ms)
+int Timidity_Seek(MidiSong *song, Uint32 ms)
+{
+  return skip_to(song, (ms * (song->rate / 100)) / 10);
+}
+
+MidiSongState *Timidity_SaveState(MidiSong *song)
+{
+  MidiSongState *state;
+  int i, count = 0;
+
+  for (i = 0; i < MAX_VOICES; i++)
+    if (song->voice[i].status != VOICE_FREE)
+      count++;
+
+  state = SDL_malloc(sizeof(MidiSongState) + (SDL_max(count, 1) - 1) * sizeof(Voice));
+  if (!state)
+    return NULL;
+
+  state->playing = song->playing;
+  state->current_sample = song->current_sample;
+  state->event_index = (Sint32)(song->current_event - song->events);
+  SDL_memcpy(state->channel, song->channel, sizeof(song->channel));
+  state->voice_count = 0;
+  for (i = 0; i < MAX_VOICES; i++)
+    if (song->voice[i].status != VOICE_FREE)
+      {
+	state->voice_index[state->voice_count] = i;
+	state->voice[state->voice_count++] = song->voice[i];
+      }
+  return state;
+}
+
+void Timidity_RestoreState(MidiSong *song, const MidiSongState *state)
+{
+  int i;
+
+  reset_voices(song);
+  for (i = 0; i < state->voice_count; i++)
+    song->voice[state->voice_index[i]] = state->voice[i];
+  SDL_memcpy(song->channel, state->channel, sizeof(song->channel));
+  song->current_event = song->events + state->event_index;
+  song->current_sample = state->current_sample;
+  song->playing = state->playing;
+}
+
+void Timidity_FreeState(MidiSongState *state)
 {
-  skip_to(song, (ms * (song->rate / 100)) / 10);
+  SDL_free(state);
 }
 
 Uint32 Timidity_GetSongLength(MidiSong *song)
@@ -665,6 +1044,7 @@ int Timidity_PlaySome(MidiSong *song, void *stream, Sint32 len)
 {
   Sint32 start_sample, end_sample, samples;
   int bytes_per_sample;
+  Uint8 *out = (Uint8 *)stream;
 
   if (!song->playing)
     return 0;
@@ -775,9 +1155,9 @@ int Timidity_PlaySome(MidiSong *song, void *stream, Sint32 len)
       song->current_event++;
     }
     if (song->current_event->time > end_sample)
-      compute_data(song, stream, end_sample-song->current_sample);
+      compute_data(song, &out, end_sample-song->current_sample, bytes_per_sample);
     else
-      compute_data(song, stream, song->current_event->time-song->current_sample);
+      compute_data(song, &out, song->current_event->time-song->current_sample, bytes_per_sample);
   }
   return samples * bytes_per_sample;
 }
@@ -53,4 +53,8 @@
 
 #define ISDRUMCHANNEL(s, c) (((s)->drumchannels & (1<<(c))))
 
+#define build_seek_index TIMI_NAMESPACE(build_seek_index)
+
+extern MidiSeekIndex *build_seek_index(MidiSong *song);
+
 #endif /* TIMIDITY_PLAYMIDI_H */
@@ -10,6 +10,7 @@
 */
 
 #include <SDL3/SDL.h>
+#include <SDL3/SDL_intrin.h>
 
 #include "timidity.h"
 #include "options.h"
@@ -21,25 +22,122 @@
 
 #define PRECALC_LOOP_COUNT(start, end, incr) (((end) - (start) + (incr) - 1) / (incr))
 
+/*************** linear interpolation spans *****************/
+
+/* Every fixed-increment inner loop below ends up here. There's no
+   gather in SSE2 or NEON, so the source fetches are scalar loads, but
+   the fraction math and the interpolation run on whole vectors. The
+   SIMD versions compute v1 + (((v2 - v1) * frac) >> FRACTION_BITS)
+   exactly like the scalar loop, so the output is bit-identical. */
+
+#ifdef SDL_SSE2_INTRINSICS
+/* The SSE2 path weights (v1, v2) by (ONE - frac, frac) in 16 bits. */
+SDL_COMPILE_TIME_ASSERT(resample_fraction_bits, FRACTION_BITS <= 14);
+
+/* src[n] and src[n+1] as one 32-bit lane, v1 in the low half. */
+static SDL_INLINE Sint32 load_pair(const sample_t *p)
+{
+  Sint32 pair;
+  SDL_memcpy(&pair, p, sizeof(pair));
+  return pair;
+}
+
+/* Four outputs: ofsv holds the four offsets, ofs the first of them. */
+static __m128i SDL_TARGETING("sse2") resample4_sse2(const sample_t *src, __m128i ofsv, Sint32 ofs, Sint32 incr)
+{
+  const Sint32 o1 = ofs + incr, o2 = o1 + incr, o3 = o2 + incr;
+  const __m128i p01 = _mm_unpacklo_epi32(_mm_cvtsi32_si128(load_pair(src + (ofs >> FRACTION_BITS))),
+					 _mm_cvtsi32_si128(load_pair(src + (o1 >> FRACTION_BITS))));
+  const __m128i p23 = _mm_unpacklo_epi32(_mm_cvtsi32_si128(load_pair(src + (o2 >> FRACTION_BITS))),
+					 _mm_cvtsi32_si128(load_pair(src + (o3 >> FRACTION_BITS))));
+  const __m128i frac = _mm_and_si128(ofsv, _mm_set1_epi32(FRACTION_MASK));
+  const __m128i weights = _mm_or_si128(_mm_slli_epi32(frac, 16),
+				       _mm_sub_epi32(_mm_set1_epi32(1 << FRACTION_BITS), frac));
+  /* v1 * (ONE - frac) + v2 * frac == (v1 << FRACTION_BITS) + (v2 - v1) * frac */
+  return _mm_srai_epi32(_mm_madd_epi16(_mm_unpacklo_epi64(p01, p23), weights), FRACTION_BITS);
+}
+
+static Sint32 SDL_TARGETING("sse2") resample_span_sse2(const sample_t *src, sample_t *dest, Sint32 ofs, Sint32 incr, Sint32 count)
+{
+  const __m128i step = _mm_set1_epi32(4 * incr);
+  __m128i ofsv = _mm_set_epi32(ofs + 3 * incr, ofs + 2 * incr, ofs + incr, ofs);
+  Sint32 i;
+  for (i = 0; i + 8 <= count; i += 8)
+    {
+      const __m128i lo = resample4_sse2(src, ofsv, ofs, incr);
+      const __m128i hi = resample4_sse2(src, _mm_add_epi32(ofsv, step), ofs + 4 * incr, incr);
+      _mm_storeu_si128((__m128i *)(dest + i), _mm_packs_epi32(lo, hi));
+      ofsv = _mm_add_epi32(ofsv, _mm_add_epi32(step, step));
+      ofs += 8 * incr;
+    }
+  return i;
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+static Sint32 resample_span_neon(const sample_t *src, sample_t *dest, Sint32 ofs, Sint32 incr, Sint32 count)
+{
+  const int32x4_t mask = vdupq_n_s32(FRACTION_MASK);
+  Sint32 i;
+  for (i = 0; i + 4 <= count; i += 4)
+    {
+      const Sint32 o[4] = { ofs, ofs + incr, ofs + 2 * incr, ofs + 3 * incr };
+      const sample_t s1[4] = { src[o[0] >> FRACTION_BITS], src[o[1] >> FRACTION_BITS],
+			       src[o[2] >> FRACTION_BITS], src[o[3] >> FRACTION_BITS] };
+      const sample_t s2[4] = { src[(o[0] >> FRACTION_BITS) + 1], src[(o[1] >> FRACTION_BITS) + 1],
+			       src[(o[2] >> FRACTION_BITS) + 1], src[(o[3] >> FRACTION_BITS) + 1] };
+      const int16x4_t v1 = vld1_s16(s1);
+      const int16x4_t v2 = vld1_s16(s2);
+      const int32x4_t frac = vandq_s32(vld1q_s32(o), mask);
+      const int32x4_t r = vmlaq_s32(vshll_n_s16(v1, FRACTION_BITS), vsubl_s16(v2, v1), frac);
+      vst1_s16(dest + i, vmovn_s32(vshrq_n_s32(r, FRACTION_BITS)));
+      ofs += 4 * incr;
+    }
+  return i;
+}
+#endif
+
+/* Interpolate count samples starting at ofs into dest. Returns the new ofs. */
+static Sint32 resample_span(const sample_t *src, sample_t *dest, Sint32 ofs, Sint32 incr, Sint32 count)
+{
+  Sint32 i = 0;
+  sample_t v1, v2;
+#if defined(SDL_SSE2_INTRINSICS)
+  if (timi_has_sse2)
+    i = resample_span_sse2(src, dest, ofs, incr, count);
+#elif defined(SDL_NEON_INTRINSICS)
+  if (timi_has_neon)
+    i = resample_span_neon(src, dest, ofs, incr, count);
+#endif
+  ofs += i * incr;
+  for (; i < count; i++)
+    {
+      v1 = src[ofs >> FRACTION_BITS];
+      v2 = src[(ofs >> FRACTION_BITS)+1];
+      dest[i] = v1 + (((v2 - v1) * (ofs & FRACTION_MASK)) >> FRACTION_BITS);
+      ofs += incr;
+    }
+  return ofs;
+}
+
 /*************** resampling with fixed increment *****************/
 
-static sample_t *rs_plain(MidiSong *song, int v, Sint32 *countptr)
+static sample_t *rs_plain(MidiSong *song, int v, Sint32 *countptr, sample_t *buf)
 {
 
   /* Play sample until end, then free the voice. */
 
-  sample_t v1, v2;
   Voice 
     *vp=&(song->voice[v]);
   sample_t 
-    *dest=song->resample_buffer,
+    *dest=buf,
     *src=vp->sample->data;
   Sint32 
     ofs=vp->sample_offset,
     incr=vp->sample_increment,
     le=vp->sample->data_length,
     count=*countptr;
-  Sint32 i, j;
+  Sint32 i;
 
   if (incr<0) incr = -incr; /* In case we're coming out of a bidir loop */
 
@@ -54,13 +152,8 @@ static sample_t *rs_plain(MidiSong *song, int v, Sint32 *countptr)
     }
   else count -= i;
 
-  for (j = 0; j < i; j++)
-    {
-      v1 = src[ofs >> FRACTION_BITS];
-      v2 = src[(ofs >> FRACTION_BITS)+1];
-      *dest++ = v1 + (((v2 - v1) * (ofs & FRACTION_MASK)) >> FRACTION_BITS);
-      ofs += incr;
-    }
+  ofs = resample_span(src, dest, ofs, incr, i);
+  dest += i;
 
   if (ofs >= le)
     {
@@ -71,23 +164,22 @@ static sample_t *rs_plain(MidiSong *song, int v, Sint32 *countptr)
     }
 
   vp->sample_offset=ofs; /* Update offset */
-  return song->resample_buffer;
+  return buf;
 }
 
-static sample_t *rs_loop(MidiSong *song, Voice *vp, Sint32 count)
+static sample_t *rs_loop(MidiSong *song, Voice *vp, Sint32 count, sample_t *buf)
 {
   /* Play sample until end-of-loop, skip back and continue. */
 
-  sample_t v1, v2;
   Sint32 
     ofs=vp->sample_offset,
     incr=vp->sample_increment,
     le=vp->sample->loop_end,
     ll=le - vp->sample->loop_start;
   sample_t
-    *dest=song->resample_buffer,
+    *dest=buf,
     *src=vp->sample->data;
-  Sint32 i, j;
+  Sint32 i;
 
   while (count)
     {
@@ -101,34 +193,28 @@ static sample_t *rs_loop(MidiSong *song, Voice *vp, Sint32 count)
 	  count = 0;
 	}
       else count -= i;
-      for (j = 0; j < i; j++)
-	{
-	  v1 = src[ofs >> FRACTION_BITS];
-	  v2 = src[(ofs >> FRACTION_BITS)+1];
-	  *dest++ = v1 + (((v2 - v1) * (ofs & FRACTION_MASK)) >> FRACTION_BITS);
-	  ofs += incr;
-	}
+      ofs = resample_span(src, dest, ofs, incr, i);
+      dest += i;
     }
 
   vp->sample_offset=ofs; /* Update offset */
-  return song->resample_buffer;
+  return buf;
 }
 
-static sample_t *rs_bidir(MidiSong *song, Voice *vp, Sint32 count)
+static sample_t *rs_bidir(MidiSong *song, Voice *vp, Sint32 count, sample_t *buf)
 {
-  sample_t v1, v2;
   Sint32 
     ofs=vp->sample_offset,
     incr=vp->sample_increment,
     le=vp->sample->loop_end,
     ls=vp->sample->loop_start;
   sample_t 
-    *dest=song->resample_buffer,
+    *dest=buf,
     *src=vp->sample->data;
   Sint32
     le2 = le<<1,
     ls2 = ls<<1,
-    i, j;
+    i;
   /* Play normally until inside the loop region */
 
   if (incr > 0 && ofs < ls)
@@ -143,13 +229,8 @@ static sample_t *rs_bidir(MidiSong *song, Voice *vp, Sint32 count)
 	  count = 0;
 	}
       else count -= i;
-      for (j = 0; j < i; j++)
-	{
-	  v1 = src[ofs >> FRACTION_BITS];
-	  v2 = src[(ofs >> FRACTION_BITS)+1];
-	  *dest++ = v1 + (((v2 - v1) * (ofs & FRACTION_MASK)) >> FRACTION_BITS);
-	  ofs += incr;
-	}
+      ofs = resample_span(src, dest, ofs, incr, i);
+      dest += i;
     }
 
   /* Then do the bidirectional looping */
@@ -163,13 +244,8 @@ static sample_t *rs_bidir(MidiSong *song, Voice *vp, Sint32 count)
 	  count = 0;
 	}
       else count -= i;
-      for (j = 0; j < i; j++)
-	{
-	  v1 = src[ofs >> FRACTION_BITS];
-	  v2 = src[(ofs >> FRACTION_BITS)+1];
-	  *dest++ = v1 + (((v2 - v1) * (ofs & FRACTION_MASK)) >> FRACTION_BITS);
-	  ofs += incr;
-	}
+      ofs = resample_span(src, dest, ofs, incr, i);
+      dest += i;
       if (ofs>=le)
 	{
 	  /* fold the overshoot back in */
@@ -185,7 +261,7 @@ static sample_t *rs_bidir(MidiSong *song, Voice *vp, Sint32 count)
 
   vp->sample_increment=incr;
   vp->sample_offset=ofs; /* Update offset */
-  return song->resample_buffer;
+  return buf;
 }
 
 /*********************** vibrato versions ***************************/
@@ -264,14 +340,14 @@ static Sint32 update_vibrato(MidiSong *song, Voice *vp, int sign)
   return (Sint32) a;
 }
 
-static sample_t *rs_vib_plain(MidiSong *song, int v, Sint32 *countptr)
+static sample_t *rs_vib_plain(MidiSong *song, int v, Sint32 *countptr, sample_t *buf)
 {
   /* Play sample until end, then free the voice. */
 
   sample_t v1, v2;
   Voice *vp=&(song->voice[v]);
   sample_t 
-    *dest=song->resample_buffer, 
+    *dest=buf, 
     *src=vp->sample->data;
   Sint32 
     le=vp->sample->data_length,
@@ -309,25 +385,24 @@ static sample_t *rs_vib_plain(MidiSong *song, int v, Sint32 *countptr)
   vp->vibrato_control_counter=cc;
   vp->sample_increment=incr;
   vp->sample_offset=ofs; /* Update offset */
-  return song->resample_buffer;
+  return buf;
 }
 
-static sample_t *rs_vib_loop(MidiSong *song, Voice *vp, Sint32 count)
+static sample_t *rs_vib_loop(MidiSong *song, Voice *vp, Sint32 count, sample_t *buf)
 {
   /* Play sample until end-of-loop, skip back and continue. */
 
-  sample_t v1, v2;
   Sint32 
     ofs=vp->sample_offset,
     incr=vp->sample_increment,
     le=vp->sample->loop_end,
     ll=le - vp->sample->loop_start;
   sample_t 
-    *dest=song->resample_buffer,
+    *dest=buf,
     *src=vp->sample->data;
   int 
     cc=vp->vibrato_control_counter;
-  Sint32 i, j;
+  Sint32 i;
   int
     vibflag=0;
 
@@ -347,13 +422,8 @@ static sample_t *rs_vib_loop(MidiSong *song, Voice *vp, Sint32 count)
 	}
       else cc -= i;
       count -= i;
-      for (j = 0; j < i; j++)
-	{
-	  v1 = src[ofs >> FRACTION_BITS];
-	  v2 = src[(ofs >> FRACTION_BITS)+1];
-	  *dest++ = v1 + (((v2 - v1) * (ofs & FRACTION_MASK)) >> FRACTION_BITS);
-	  ofs += incr;
-	}
+      ofs = resample_span(src, dest, ofs, incr, i);
+      dest += i;
       if(vibflag)
 	{
 	  cc = vp->vibrato_control_ratio;
@@ -365,26 +435,25 @@ static sample_t *rs_vib_loop(MidiSong *song, Voice *vp, Sint32 count)
   vp->vibrato_control_counter=cc;
   vp->sample_increment=incr;
   vp->sample_offset=ofs; /* Update offset */
-  return song->resample_buffer;
+  return buf;
 }
 
-static sample_t *rs_vib_bidir(MidiSong *song, Voice *vp, Sint32 count)
+static sample_t *rs_vib_bidir(MidiSong *song, Voice *vp, Sint32 count, sample_t *buf)
 {
-  sample_t v1, v2;
   Sint32 
     ofs=vp->sample_offset,
     incr=vp->sample_increment,
     le=vp->sample->loop_end,
     ls=vp->sample->loop_start;
   sample_t 
-    *dest=song->resample_buffer,
+    *dest=buf,
     *src=vp->sample->data;
   int 
     cc=vp->vibrato_control_counter;
   Sint32
     le2=le<<1,
     ls2=ls<<1,
-    i, j;
+    i;
   int
     vibflag = 0;
 
@@ -400,13 +469,8 @@ static sample_t *rs_vib_bidir(MidiSong *song, Voice *vp, Sint32 count)
 	}
       else cc -= i;
       count -= i;
-      for (j = 0; j < i; j++)
-	{
-	  v1 = src[ofs >> FRACTION_BITS];
-	  v2 = src[(ofs >> FRACTION_BITS)+1];
-	  *dest++ = v1 + (((v2 - v1) * (ofs & FRACTION_MASK)) >> FRACTION_BITS);
-	  ofs += incr;
-	}
+      ofs = resample_span(src, dest, ofs, incr, i);
+      dest += i;
       if (vibflag)
 	{
 	  cc = vp->vibrato_control_ratio;
@@ -428,13 +492,8 @@ static sample_t *rs_vib_bidir(MidiSong *song, Voice *vp, Sint32 count)
 	}
       else cc -= i;
       count -= i;
-      while (i--)
-	{
-	  v1 = src[ofs >> FRACTION_BITS];
-	  v2 = src[(ofs >> FRACTION_BITS)+1];
-	  *dest++ = v1 + (((v2 - v1) * (ofs & FRACTION_MASK)) >> FRACTION_BITS);
-	  ofs += incr;
-	}
+      ofs = resample_span(src, dest, ofs, incr, i);
+      dest += i;
       if (vibflag)
 	{
 	  cc = vp->vibrato_control_ratio;
@@ -457,10 +516,11 @@ static sample_t *rs_vib_bidir(MidiSong *song, Voice *vp, Sint32 count)
   vp->vibrato_control_counter=cc;
   vp->sample_increment=incr;
   vp->sample_offset=ofs; /* Update offset */
-  return song->resample_buffer;
+  return buf;
 }
 
-sample_t *resample_voice(MidiSong *song, int v, Sint32 *countptr)
+/* buf must hold at least *countptr samples. */
+sample_t *resample_voice(MidiSong *song, int v, Sint32 *countptr, sample_t *buf)
 {
   Sint32 ofs;
   Uint8 modes;
@@ -496,12 +556,12 @@ sample_t *resample_voice(MidiSong *song, int v, Sint32 *countptr)
 	   (vp->status==VOICE_ON || vp->status==VOICE_SUSTAINED)))
 	{
 	  if (modes & MODES_PINGPONG)
-	    return rs_vib_bidir(song, vp, *countptr);
+	    return rs_vib_bidir(song, vp, *countptr, buf);
 	  else
-	    return rs_vib_loop(song, vp, *countptr);
+	    return rs_vib_loop(song, vp, *countptr, buf);
 	}
       else
-	return rs_vib_plain(song, v, countptr);
+	return rs_vib_plain(song, v, countptr, buf);
     }
   else
     {
@@ -510,12 +570,12 @@ sample_t *resample_voice(MidiSong *song, int v, Sint32 *countptr)
 	   (vp->status==VOICE_ON || vp->status==VOICE_SUSTAINED)))
 	{
 	  if (modes & MODES_PINGPONG)
-	    return rs_bidir(song, vp, *countptr);
+	    return rs_bidir(song, vp, *countptr, buf);
 	  else
-	    return rs_loop(song, vp, *countptr);
+	    return rs_loop(song, vp, *countptr, buf);
 	}
       else
-	return rs_plain(song, v, countptr);
+	return rs_plain(song, v, countptr, buf);
     }
 }
 
@@ -14,7 +14,7 @@
 #define resample_voice TIMI_NAMESPACE(resample_voice)
 #define pre_resample TIMI_NAMESPACE(pre_resample)
 
-extern sample_t *resample_voice(MidiSong *song, int v, Sint32 *countptr);
+extern sample_t *resample_voice(MidiSong *song, int v, Sint32 *countptr, sample_t *buf);
 extern void pre_resample(MidiSong *song, Sample *sp);
 
 #endif /* TIMIDITY_RESAMPLE_H */
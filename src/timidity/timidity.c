@@ -7,6 +7,7 @@
 */
 
 #include <SDL3/SDL.h>
+#include <SDL3/SDL_intrin.h>
 
 #include "timidity.h"
 
@@ -22,6 +23,13 @@
 
 static ToneBank *master_tonebank[MAXBANK], *master_drumset[MAXBANK];
 
+#ifdef SDL_SSE2_INTRINSICS
+bool timi_has_sse2 = false;
+#endif
+#ifdef TIMI_NEED_NEON_CHECK
+bool timi_has_neon = false;
+#endif
+
 static char def_instr_name[256] = "";
 
 #define MAXWORDS 10
@@ -543,6 +551,14 @@ int Timidity_Init_NoConfig(void)
 {
   master_tonebank[0] = NULL;
   master_drumset[0] = NULL;
+  if (init_instrument_cache() < 0)
+    return -1;
+#ifdef SDL_SSE2_INTRINSICS
+  timi_has_sse2 = SDL_HasSSE2();
+#endif
+#ifdef TIMI_NEED_NEON_CHECK
+  timi_has_neon = SDL_HasNEON();
+#endif
   return init_alloc_banks();
 }
 
@@ -582,19 +598,17 @@ int Timidity_SetSoundfont(const char *file)
   return 0;
 }
 
-static void do_song_load(SDL_IOStream *io, const SDL_AudioSpec *audio, MidiSong **out, int samples)
+/* Everything read_midi_file() needs, so the events it grooms are the
+   same whether or not the song goes on to load instruments. */
+static MidiSong *new_song(SDL_IOStream *io, const SDL_AudioSpec *audio)
 {
   MidiSong *song;
   int i;
 
-  *out = NULL;
-  if (io == NULL)
-      return;
-
   /* Allocate memory for the song */
   song = (MidiSong *)SDL_calloc(1, sizeof(*song));
   if (song == NULL)
-      return;
+      return NULL;
 
   for (i = 0; i < MAXBANK; i++)
   {
@@ -617,6 +631,25 @@ static void do_song_load(SDL_IOStream *io, const SDL_AudioSpec *audio, MidiSong
   song->io = io;
 
   song->rate = audio->freq;
+  return song;
+
+fail:
+  Timidity_FreeSong(song);
+  return NULL;
+}
+
+static void do_song_load(SDL_IOStream *io, const SDL_AudioSpec *audio, MidiSong **out, int samples)
+{
+  MidiSong *song;
+
+  *out = NULL;
+  if (io == NULL)
+      return;
+
+  song = new_song(io, audio);
+  if (song == NULL)
+      return;
+
   song->encoding = 0;
   if ((audio->format & 0xFF) == 16)
       song->encoding |= PE_16BIT;
@@ -709,12 +742,47 @@ MidiSong *Timidity_LoadSong(SDL_IOStream *io, const SDL_AudioSpec *audio, int sa
   return song;
 }
 
+MidiSeekIndex *Timidity_BuildSeekIndex(SDL_IOStream *io, const SDL_AudioSpec *audio)
+{
+  MidiSeekIndex *index = NULL;
+  MidiSong *song;
+
+  if (io == NULL)
+      return NULL;
+
+  song = new_song(io, audio);
+  if (song == NULL)
+      return NULL;
+
+  song->events = read_midi_file(song, &(song->groomed_event_count),
+      &song->samples);
+  if (song->events && !song->oom)
+      index = build_seek_index(song);
+
+  Timidity_FreeSong(song);
+  return index;
+}
+
+void Timidity_SetSeekIndex(MidiSong *song, const MidiSeekIndex *index)
+{
+  song->seek_index = index;
+}
+
+void Timidity_FreeSeekIndex(MidiSeekIndex *index)
+{
+  if (!index) return;
+  SDL_free(index->points);
+  SDL_free(index->notes);
+  SDL_free(index);
+}
+
 void Timidity_FreeSong(MidiSong *song)
 {
   int i, j;
 
   if (!song) return;
 
+  Timidity_SetThreads(song, 1);
   free_instruments(song);
 
   for (i = 0; i < 128; i++) {
@@ -768,6 +836,7 @@ void Timidity_Exit(void)
     }
   }
 
+  end_instrument_cache();
   end_soundfont();
   end_sbk();
   SDL_free(sf_file);
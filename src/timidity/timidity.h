@@ -108,12 +108,53 @@ typedef struct {
     Uint8 channel, type, a, b;
 } MidiEvent;
 
+typedef struct {
+    Sint32 time;
+    Sint32 event_index; /* first event at or after `time` */
+    Channel channel[MAXCHAN];
+    Sint32 note_index, note_count; /* notes held at `time`, in MidiSeekIndex.notes */
+} MidiSeekPoint;
+
+/* Seek points for one MIDI file at one output rate. Built once with
+   Timidity_BuildSeekIndex() and shared read-only by every song that
+   plays that file at that rate. */
+typedef struct {
+    MidiSeekPoint *points;
+    Sint32 point_count;
+    Sint32 *notes;
+} MidiSeekIndex;
+
+/* Everything that changes while a song plays, for Timidity_SaveState(). */
+typedef struct {
+    int playing;
+    Sint32 current_sample;
+    Sint32 event_index;
+    Channel channel[MAXCHAN];
+    int voice_count; /* only the voices that were in use are saved */
+    int voice_index[MAX_VOICES];
+    Voice voice[1]; /* actually voice_count of them */
+} MidiSongState;
+
+struct _MidiSong;
+
+/* A helper thread that mixes a share of the active voices into its own
+   buffer; see Timidity_SetThreads(). */
+typedef struct {
+    struct _MidiSong *song;
+    SDL_Thread *thread;
+    SDL_Semaphore *start;
+    Sint32 *mix_buffer;
+    sample_t *resample_buffer;
+    int first_voice, end_voice; /* range in song->active_voices */
+    Sint32 count;
+} MidiWorker;
+
 typedef struct _MidiEventList {
     MidiEvent event;
     struct _MidiEventList *next;
 } MidiEventList;
 
-typedef struct {
+typedef struct _MidiSong {
     int oom; /* malloc() failed */
     int playing;
     SDL_IOStream *io;
@@ -129,7 +170,6 @@ typedef struct {
     int buffer_size;
     sample_t *resample_buffer;
     Sint32 *common_buffer;
-    Sint32 *buffer_pointer;
     /* These would both fit into 32 bits, but they are often added in
        large multiples, so it's simpler to have two roomy ints */
     /* samples per MIDI delta-t */
@@ -139,7 +179,6 @@ typedef struct {
     Voice voice[MAX_VOICES];
     int voices;
     Sint32 drumchannels;
-    Sint32 buffered_count;
     Sint32 control_ratio;
     Sint32 lost_notes;
     Sint32 cut_notes;
@@ -151,6 +190,16 @@ typedef struct {
     Sint32 event_count;
     Sint32 at;
     Sint32 groomed_event_count;
+    const MidiSeekIndex *seek_index; /* not owned, may be NULL */
+    /* For each channel and key, 1 + the index of the Note On event that
+       is holding it down, negated if the key is up but the sustain pedal
+       is keeping it alive, or 0 if it's silent. Only used while seeking. */
+    Sint32 held_notes[MAXCHAN][128];
+    MidiWorker *workers;
+    int worker_count;
+    int workers_quit;
+    SDL_Semaphore *workers_done;
+    int active_voices[MAX_VOICES];
 } MidiSong;
 
 /* Some of these are not defined in timidity.c but are here for convenience */
@@ -164,9 +213,26 @@ extern int Timidity_Init_NoConfig(void);
 extern int Timidity_SetSoundfont(const char *sf2_file);
 extern void Timidity_SetVolume(MidiSong *song, int volume);
 extern int Timidity_PlaySome(MidiSong *song, void *stream, Sint32 len);
+/* Mix voices on up to `threads` threads (the caller's included). The
+ * output is bit-identical to mixing on one thread. 1 stops the helper
+ * threads. Returns 0 on success; on failure the song mixes on one thread. */
+extern int Timidity_SetThreads(MidiSong *song, int threads);
 extern MidiSong *Timidity_LoadSong(SDL_IOStream *io, const SDL_AudioSpec *audio, int samples);
+/* Read the events in `io` without loading any instruments and index
+ * them for seeking at audio->freq. Returns NULL if the song is too short
+ * to need an index or on failure; songs without one just seek slower. */
+extern MidiSeekIndex *Timidity_BuildSeekIndex(SDL_IOStream *io, const SDL_AudioSpec *audio);
+/* The index must outlive the song, and match its file and rate. */
+extern void Timidity_SetSeekIndex(MidiSong *song, const MidiSeekIndex *index);
+extern void Timidity_FreeSeekIndex(MidiSeekIndex *index);
 extern void Timidity_Start(MidiSong *song);
-extern void Timidity_Seek(MidiSong *song, Uint32 ms);
+extern int Timidity_Seek(MidiSong *song, Uint32 ms); /* returns 0 if past the end */
+/* Save the playback position and the state of every channel and voice,
+ * so Timidity_RestoreState() can jump back there without replaying
+ * anything. Returns NULL if out of memory. */
+extern MidiSongState *Timidity_SaveState(MidiSong *song);
+extern void Timidity_RestoreState(MidiSong *song, const MidiSongState *state);
+extern void Timidity_FreeState(MidiSongState *state);
 extern Uint32 Timidity_GetSongLength(MidiSong *song); /* returns millseconds */
 extern Uint32 Timidity_GetSongTime(MidiSong *song);   /* returns millseconds */
 extern void Timidity_Stop(MidiSong *song);
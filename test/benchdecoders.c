@@ -0,0 +1,325 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2026 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+/*
+  This is a headless benchmark of the decoders. It runs every file through
+  every available decoder that will accept it, and reports how long loading
+  (init_audio) and track setup (init_track) take, how long a seek takes, how
+  fast it decodes compared to realtime, and the peak memory used through
+  SDL's allocator while doing so (libraries that call malloc() directly
+  aren't counted).
+
+  A small corpus of WAV (PCM, float and IMA ADPCM) and AIFF files is
+  generated in memory, by the same code testrender uses. Pass more files on the command line to compare
+  compressed formats, like MP3 through both DRMP3 and MPG123.
+*/
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include "SDL3_mixer/SDL_mixer.h"
+#include "testcorpus.h"
+
+#define NUM_SEEKS 16
+
+// Memory accounting. Every allocation gets a header with its size, so we can track how much is outstanding.
+typedef union AllocHeader
+{
+    size_t size;
+    Uint64 align64;  // keep the payload as aligned as malloc's would be.
+    double alignd;
+    void *alignp;
+} AllocHeader;
+
+static SDL_malloc_func orig_malloc;
+static SDL_calloc_func orig_calloc;
+static SDL_realloc_func orig_realloc;
+static SDL_free_func orig_free;
+static SDL_Mutex *memory_lock;
+static size_t memory_current;
+static size_t memory_peak;
+
+static void TrackAllocation(Sint64 delta)
+{
+    if (memory_lock) {
+        SDL_LockMutex(memory_lock);
+    }
+    memory_current = (size_t) ((Sint64) memory_current + delta);
+    memory_peak = SDL_max(memory_peak, memory_current);
+    if (memory_lock) {
+        SDL_UnlockMutex(memory_lock);
+    }
+}
+
+static void * SDLCALL TrackingMalloc(size_t size)
+{
+    AllocHeader *hdr = (AllocHeader *) orig_malloc(sizeof (AllocHeader) + size);
+    if (!hdr) {
+        return NULL;
+    }
+    hdr->size = size;
+    TrackAllocation((Sint64) size);
+    return hdr + 1;
+}
+
+static void * SDLCALL TrackingCalloc(size_t nmemb, size_t size)
+{
+    if (size && (nmemb > (SDL_SIZE_MAX - sizeof (AllocHeader)) / size)) {
+        return NULL;
+    }
+    AllocHeader *hdr = (AllocHeader *) orig_calloc(1, sizeof (AllocHeader) + (nmemb * size));
+    if (!hdr) {
+        return NULL;
+    }
+    hdr->size = nmemb * size;
+    TrackAllocation((Sint64) hdr->size);
+    return hdr + 1;
+}
+
+static void * SDLCALL TrackingRealloc(void *mem, size_t size)
+{
+    AllocHeader *hdr = mem ? (((AllocHeader *) mem) - 1) : NULL;
+    const size_t oldsize = hdr ? hdr->size : 0;
+    hdr = (AllocHeader *) orig_realloc(hdr, sizeof (AllocHeader) + size);
+    if (!hdr) {
+        return NULL;
+    }
+    hdr->size = size;
+    TrackAllocation((Sint64) size - (Sint64) oldsize);
+    return hdr + 1;
+}
+
+static void SDLCALL TrackingFree(void *mem)
+{
+    if (mem) {
+        AllocHeader *hdr = ((AllocHeader *) mem) - 1;
+        TrackAllocation(-(Sint64) hdr->size);
+        orig_free(hdr);
+    }
+}
+
+static size_t ResetPeakMemory(void)
+{
+    SDL_LockMutex(memory_lock);
+    memory_peak = memory_current;
+    const size_t retval = memory_current;
+    SDL_UnlockMutex(memory_lock);
+    return retval;
+}
+
+static size_t GetPeakMemory(void)
+{
+    SDL_LockMutex(memory_lock);
+    const size_t retval = memory_peak;
+    SDL_UnlockMutex(memory_lock);
+    return retval;
+}
+
+static double NSToMS(Uint64 ns)
+{
+    return (double) ns / (double) SDL_NS_PER_MS;
+}
+
+// Move `file` into the corpus. We only benchmark decoding, so the reference decode of generated files isn't needed.
+static bool AddCorpusFile(TestFile **corpus, int *num_corpus, TestFile *file)
+{
+    SDL_free(file->reference);
+    file->reference = NULL;
+
+    void *ptr = SDL_realloc(*corpus, (*num_corpus + 1) * sizeof (TestFile));
+    if (!ptr) {
+        FreeTestFile(file);
+        return false;
+    }
+    *corpus = (TestFile *) ptr;
+    SDL_copyp(&(*corpus)[(*num_corpus)++], file);
+    return true;
+}
+
+static void BenchmarkDecoder(MIX_Mixer *mixer, const TestFile *file, const char *decoder_name)
+{
+    Uint64 start;
+
+    const size_t baseline = ResetPeakMemory();
+
+    // loading runs the decoder's init_audio (and copies the file data, like a normal load would).
+    const SDL_PropertiesID props = SDL_CreateProperties();
+    SDL_SetPointerProperty(props, MIX_PROP_AUDIO_LOAD_IOSTREAM_POINTER, SDL_IOFromConstMem(file->data, file->datalen));
+    SDL_SetBooleanProperty(props, MIX_PROP_AUDIO_LOAD_CLOSEIO_BOOLEAN, true);
+    SDL_SetPointerProperty(props, MIX_PROP_AUDIO_LOAD_PREFERRED_MIXER_POINTER, mixer);
+    SDL_SetStringProperty(props, MIX_PROP_AUDIO_DECODER_STRING, decoder_name);
+    start = SDL_GetTicksNS();
+    MIX_Audio *audio = MIX_LoadAudioWithProperties(props);
+    const Uint64 init_audio_ns = SDL_GetTicksNS() - start;
+    SDL_DestroyProperties(props);
+
+    if (!audio) {
+        return;  // this decoder doesn't handle this file, that's fine.
+    }
+
+    // assigning it to a track runs init_track.
+    MIX_Track *track = MIX_CreateTrack(mixer);
+    if (!track) {
+        SDL_Log("%-24s %-12s couldn't create track: %s", file->name, decoder_name, SDL_GetError());
+        MIX_DestroyAudio(audio);
+        return;
+    }
+
+    start = SDL_GetTicksNS();
+    const bool track_okay = MIX_SetTrackAudio(track, audio);
+    const Uint64 init_track_ns = SDL_GetTicksNS() - start;
+    if (!track_okay) {
+        SDL_Log("%-24s %-12s init_track failed: %s", file->name, decoder_name, SDL_GetError());
+        MIX_DestroyTrack(track);
+        MIX_DestroyAudio(audio);
+        return;
+    }
+
+    // seek around in a scattered order, so we aren't just measuring short forward hops.
+    double seek_ms = -1.0;
+    const Sint64 duration = MIX_GetAudioDuration(audio);
+    if (duration > 0) {
+        int seeks = 0;
+        start = SDL_GetTicksNS();
+        for (int i = 0; i < NUM_SEEKS; i++) {
+            const Sint64 frame = (duration * ((i * 7) % NUM_SEEKS)) / NUM_SEEKS;
+            if (MIX_SetTrackPlaybackPosition(track, frame)) {
+                seeks++;
+            }
+        }
+        if (seeks > 0) {
+            seek_ms = NSToMS(SDL_GetTicksNS() - start) / (double) seeks;
+        }
+    }
+
+    MIX_DestroyTrack(track);
+    MIX_DestroyAudio(audio);
+
+    // now decode the whole thing, in the decoder's own format so we don't measure conversion or resampling.
+    const SDL_PropertiesID decprops = SDL_CreateProperties();
+    SDL_SetStringProperty(decprops, MIX_PROP_AUDIO_DECODER_STRING, decoder_name);
+    MIX_AudioDecoder *audiodecoder = MIX_CreateAudioDecoder_IO(SDL_IOFromConstMem(file->data, file->datalen), true, decprops);
+    SDL_DestroyProperties(decprops);
+
+    double realtime = -1.0;
+    if (audiodecoder) {
+        SDL_AudioSpec spec;
+        MIX_GetAudioDecoderFormat(audiodecoder, &spec);
+        Uint8 buffer[16 * 1024];
+        Uint64 total = 0;
+        int br;
+        start = SDL_GetTicksNS();
+        while ((br = MIX_DecodeAudio(audiodecoder, buffer, sizeof (buffer), &spec)) > 0) {
+            total += (Uint64) br;
+        }
+        const Uint64 elapsed = SDL_GetTicksNS() - start;
+        MIX_DestroyAudioDecoder(audiodecoder);
+
+        const double seconds_decoded = (double) (total / SDL_AUDIO_FRAMESIZE(spec)) / (double) spec.freq;
+        if (elapsed > 0) {
+            realtime = seconds_decoded / ((double) elapsed / (double) SDL_NS_PER_SECOND);
+        }
+    }
+
+    const double peak_kb = (double) (GetPeakMemory() - baseline) / 1024.0;
+
+    SDL_Log("%-24s %-12s %9.3f %9.3f %9.3f %10.1f %10.1f",
+            file->name, decoder_name, NSToMS(init_audio_ns), NSToMS(init_track_ns), seek_ms, realtime, peak_kb);
+}
+
+int main(int argc, char *argv[])
+{
+    TestFile *corpus = NULL;
+    int num_corpus = 0;
+    int seconds = 30;
+    bool generate = true;
+
+    // track memory through SDL's allocator. This has to happen before anything else allocates.
+    SDL_GetOriginalMemoryFunctions(&orig_malloc, &orig_calloc, &orig_realloc, &orig_free);
+    SDL_SetMemoryFunctions(TrackingMalloc, TrackingCalloc, TrackingRealloc, TrackingFree);
+    memory_lock = SDL_CreateMutex();
+
+    SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");  // we never open a device, but MIX_Init initializes the audio subsystem.
+
+    if (!MIX_Init()) {
+        SDL_Log("Couldn't initialize SDL_mixer: %s", SDL_GetError());
+        return 1;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        if ((SDL_strcmp(arg, "--seconds") == 0) && (i < (argc - 1))) {
+            seconds = SDL_max(SDL_atoi(argv[++i]), 1);
+        } else if (SDL_strcmp(arg, "--no-generate") == 0) {
+            generate = false;
+        } else if (SDL_strncmp(arg, "--", 2) == 0) {
+            SDL_Log("USAGE: %s [--seconds N] [--no-generate] [file1 [file2 ...]]", argv[0]);
+            return 1;
+        } else {
+            TestFile file;
+            SDL_zero(file);
+            file.data = SDL_LoadFile(arg, &file.datalen);
+            const char *basename = SDL_strrchr(arg, '/');
+            SDL_strlcpy(file.name, basename ? basename + 1 : arg, sizeof (file.name));
+            if (!file.data || !AddCorpusFile(&corpus, &num_corpus, &file)) {
+                SDL_Log("Couldn't load '%s': %s", arg, SDL_GetError());
+            }
+        }
+    }
+
+    if (generate) {
+        TestFile file;
+        if (!GenerateWAV(&file, "wav-s16-2ch-44100", ENCODING_S16LE, 2, 44100, seconds) || !AddCorpusFile(&corpus, &num_corpus, &file) ||
+            !GenerateWAV(&file, "wav-f32-2ch-48000", ENCODING_F32LE, 2, 48000, seconds) || !AddCorpusFile(&corpus, &num_corpus, &file) ||
+            !GenerateIMAADPCMWAV(&file, "wav-ima-2ch-44100", 2, 44100, seconds) || !AddCorpusFile(&corpus, &num_corpus, &file) ||
+            !GenerateAIFF(&file, "aiff-s16-2ch-44100", 2, 44100, seconds) || !AddCorpusFile(&corpus, &num_corpus, &file)) {
+            SDL_Log("Couldn't generate test files: %s", SDL_GetError());
+            return 1;
+        }
+    }
+
+    const SDL_AudioSpec spec = { SDL_AUDIO_F32, 2, 48000 };
+    MIX_Mixer *mixer = MIX_CreateMixer(&spec);
+    if (!mixer) {
+        SDL_Log("Couldn't create mixer: %s", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Log("%-24s %-12s %9s %9s %9s %10s %10s", "file", "decoder", "load ms", "track ms", "seek ms", "realtime", "peak KB");
+
+    const int num_decoders = MIX_GetNumAudioDecoders();
+    for (int i = 0; i < num_corpus; i++) {
+        for (int j = 0; j < num_decoders; j++) {
+            BenchmarkDecoder(mixer, &corpus[i], MIX_GetAudioDecoder(j));
+        }
+    }
+
+    MIX_DestroyMixer(mixer);
+
+    for (int i = 0; i < num_corpus; i++) {
+        FreeTestFile(&corpus[i]);
+    }
+    SDL_free(corpus);
+
+    MIX_Quit();
+    SDL_Quit();
+
+    return 0;
+}
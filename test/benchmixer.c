@@ -0,0 +1,314 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2026 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+/*
+  This is a headless benchmark of the mixer itself. It builds a few synthetic
+  scenes in memory, drives them with MIX_Generate() as fast as possible, and
+  reports throughput. No audio device is opened, so it can run on any box
+  (it asks SDL for the "dummy" audio driver unless SDL_AUDIO_DRIVER says
+  otherwise).
+*/
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include "SDL3_mixer/SDL_mixer.h"
+
+#define NUM_GROUPS 4
+
+typedef enum Scene
+{
+    SCENE_PLAIN,     // tracks at mixed sample rates, no extras.
+    SCENE_3D,        // ...each positioned in 3D space.
+    SCENE_FADED,     // ...each fading in, and restarting with a fade every so often.
+    SCENE_GROUPED,   // ...spread over groups, with track and group callbacks.
+    SCENE_MAX
+} Scene;
+
+static const char *scene_names[SCENE_MAX] = { "plain", "3d", "faded", "grouped" };
+
+static SDL_malloc_func orig_malloc;
+static SDL_calloc_func orig_calloc;
+static SDL_realloc_func orig_realloc;
+static SDL_free_func orig_free;
+static SDL_AtomicInt num_allocations;
+
+static void * SDLCALL CountingMalloc(size_t size)
+{
+    SDL_AddAtomicInt(&num_allocations, 1);
+    return orig_malloc(size);
+}
+
+static void * SDLCALL CountingCalloc(size_t nmemb, size_t size)
+{
+    SDL_AddAtomicInt(&num_allocations, 1);
+    return orig_calloc(nmemb, size);
+}
+
+static void * SDLCALL CountingRealloc(void *mem, size_t size)
+{
+    SDL_AddAtomicInt(&num_allocations, 1);
+    return orig_realloc(mem, size);
+}
+
+static void SDLCALL CountingFree(void *mem)
+{
+    orig_free(mem);
+}
+
+static void SDLCALL TrackCallback(void *userdata, MIX_Track *track, const SDL_AudioSpec *spec, float *pcm, int samples)
+{
+    // touch the data a little, like an app might when metering.
+    float *peak = (float *) userdata;
+    for (int i = 0; i < samples; i += 64) {
+        *peak = SDL_max(*peak, SDL_fabsf(pcm[i]));
+    }
+}
+
+static void SDLCALL GroupCallback(void *userdata, MIX_Group *group, const SDL_AudioSpec *spec, float *pcm, int samples)
+{
+    TrackCallback(userdata, NULL, spec, pcm, samples);
+}
+
+static MIX_Audio *CreateToneAudio(MIX_Mixer *mixer, int freq, int channels, int hz)
+{
+    const SDL_AudioSpec spec = { SDL_AUDIO_F32, channels, freq };
+    const int frames = freq;  // one second, looped.
+    float *pcm = (float *) SDL_malloc(frames * channels * sizeof (float));
+    if (!pcm) {
+        return NULL;
+    }
+
+    for (int i = 0; i < frames; i++) {
+        const float sample = 0.1f * SDL_sinf(2.0f * SDL_PI_F * (float) hz * (float) i / (float) freq);
+        for (int j = 0; j < channels; j++) {
+            pcm[(i * channels) + j] = sample;
+        }
+    }
+
+    return MIX_LoadRawAudioNoCopy(mixer, pcm, frames * channels * sizeof (float), &spec, true);
+}
+
+static bool PlayLooping(MIX_Track *track, Sint64 fade_in_ms)
+{
+    const SDL_PropertiesID options = SDL_CreateProperties();
+    if (!options) {
+        return false;
+    }
+    SDL_SetNumberProperty(options, MIX_PROP_PLAY_LOOPS_NUMBER, -1);
+    if (fade_in_ms > 0) {
+        SDL_SetNumberProperty(options, MIX_PROP_PLAY_FADE_IN_MILLISECONDS_NUMBER, fade_in_ms);
+    }
+    const bool retval = MIX_PlayTrack(track, options);
+    SDL_DestroyProperties(options);
+    return retval;
+}
+
+static bool RunScene(Scene scene, const SDL_AudioSpec *spec, int num_tracks, int block_frames, double seconds)
+{
+    static const int rates[] = { 22050, 32000, 44100, 48000 };
+    MIX_Audio *audio[SDL_arraysize(rates)];
+    MIX_Group *groups[NUM_GROUPS];
+    MIX_Track **tracks = NULL;
+    float *buffer = NULL;
+    float peak = 0.0f;
+    bool retval = false;
+
+    SDL_zeroa(audio);
+    SDL_zeroa(groups);
+
+    MIX_Mixer *mixer = MIX_CreateMixer(spec);
+    if (!mixer) {
+        SDL_Log("Couldn't create mixer: %s", SDL_GetError());
+        return false;
+    }
+
+    const int buflen = block_frames * SDL_AUDIO_FRAMESIZE(*spec);
+    buffer = (float *) SDL_malloc(buflen);
+    tracks = (MIX_Track **) SDL_calloc(num_tracks, sizeof (*tracks));
+    if (!buffer || !tracks) {
+        goto done;
+    }
+
+    for (int i = 0; i < (int) SDL_arraysize(rates); i++) {
+        audio[i] = CreateToneAudio(mixer, rates[i], (i & 1) ? 1 : 2, 220 + (i * 110));
+        if (!audio[i]) {
+            SDL_Log("Couldn't create audio: %s", SDL_GetError());
+            goto done;
+        }
+    }
+
+    if (scene == SCENE_GROUPED) {
+        for (int i = 0; i < NUM_GROUPS; i++) {
+            if ((groups[i] = MIX_CreateGroup(mixer)) == NULL) {
+                SDL_Log("Couldn't create group: %s", SDL_GetError());
+                goto done;
+            }
+            MIX_SetGroupPostMixCallback(groups[i], GroupCallback, &peak);
+        }
+    }
+
+    for (int i = 0; i < num_tracks; i++) {
+        MIX_Track *track = tracks[i] = MIX_CreateTrack(mixer);
+        if (!track || !MIX_SetTrackAudio(track, audio[i % SDL_arraysize(audio)])) {
+            SDL_Log("Couldn't create track: %s", SDL_GetError());
+            goto done;
+        }
+
+        if (scene == SCENE_3D) {
+            const float angle = 2.0f * SDL_PI_F * (float) i / (float) num_tracks;
+            const MIX_Point3D position = { SDL_cosf(angle) * 5.0f, 0.0f, SDL_sinf(angle) * 5.0f };
+            MIX_SetTrack3DPosition(track, &position);
+        } else if (scene == SCENE_GROUPED) {
+            MIX_SetTrackGroup(track, groups[i % NUM_GROUPS]);
+            MIX_SetTrackRawCallback(track, TrackCallback, &peak);
+            MIX_SetTrackCookedCallback(track, TrackCallback, &peak);
+        }
+
+        if (!PlayLooping(track, (scene == SCENE_FADED) ? 1000 : 0)) {
+            SDL_Log("Couldn't play track: %s", SDL_GetError());
+            goto done;
+        }
+    }
+
+    const Uint64 total_frames = (Uint64) (seconds * spec->freq);
+    const Uint64 restart_interval = (Uint64) spec->freq / 4;  // for the faded scene, restart one track every quarter second.
+    Uint64 frames = 0;
+    Uint64 blocks = 0;
+    Uint64 next_restart = restart_interval;
+    int next_restart_track = 0;
+
+    MIX_Generate(mixer, buffer, buflen);  // warm up (lets buffers grow to size, etc) before we start counting.
+
+    const int allocs_before = SDL_GetAtomicInt(&num_allocations);
+    const Uint64 start = SDL_GetTicksNS();
+    while (frames < total_frames) {
+        if ((scene == SCENE_FADED) && (frames >= next_restart)) {
+            PlayLooping(tracks[next_restart_track], 250);
+            next_restart_track = (next_restart_track + 1) % num_tracks;
+            next_restart += restart_interval;
+        }
+        if (MIX_Generate(mixer, buffer, buflen) != buflen) {
+            SDL_Log("MIX_Generate failed: %s", SDL_GetError());
+            goto done;
+        }
+        frames += block_frames;
+        blocks++;
+    }
+    const Uint64 elapsed = SDL_GetTicksNS() - start;
+    const int allocs = SDL_GetAtomicInt(&num_allocations) - allocs_before;
+
+    const double elapsed_seconds = (double) elapsed / (double) SDL_NS_PER_SECOND;
+    SDL_Log("%-8s %6d tracks  %12.0f frames/sec  %8.1fx realtime  %10.1f ns/track/block  %6.3f allocs/block",
+            scene_names[scene], num_tracks,
+            (double) frames / elapsed_seconds,
+            ((double) frames / (double) spec->freq) / elapsed_seconds,
+            (double) elapsed / ((double) blocks * (double) num_tracks),
+            (double) allocs / (double) blocks);
+
+    retval = true;
+
+done:
+    MIX_DestroyMixer(mixer);  // this destroys the tracks and groups, too.
+    for (int i = 0; i < (int) SDL_arraysize(audio); i++) {
+        MIX_DestroyAudio(audio[i]);
+    }
+    SDL_free(tracks);
+    SDL_free(buffer);
+    return retval;
+}
+
+int main(int argc, char *argv[])
+{
+    SDL_AudioSpec spec = { SDL_AUDIO_F32, 2, 48000 };
+    int track_counts[16];
+    int num_track_counts = 0;
+    int block_frames = 1024;
+    double seconds = 10.0;
+    int scene = -1;
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *nextarg = (i < (argc - 1)) ? argv[i + 1] : NULL;
+        if ((SDL_strcmp(arg, "--tracks") == 0) && nextarg && (num_track_counts < (int) SDL_arraysize(track_counts))) {
+            track_counts[num_track_counts++] = SDL_max(SDL_atoi(nextarg), 1);
+            i++;
+        } else if ((SDL_strcmp(arg, "--block") == 0) && nextarg) {
+            block_frames = SDL_max(SDL_atoi(nextarg), 1);
+            i++;
+        } else if ((SDL_strcmp(arg, "--seconds") == 0) && nextarg) {
+            seconds = SDL_max(SDL_atof(nextarg), 0.1);
+            i++;
+        } else if ((SDL_strcmp(arg, "--rate") == 0) && nextarg) {
+            spec.freq = SDL_max(SDL_atoi(nextarg), 8000);
+            i++;
+        } else if ((SDL_strcmp(arg, "--channels") == 0) && nextarg) {
+            spec.channels = SDL_clamp(SDL_atoi(nextarg), 1, 8);
+            i++;
+        } else if ((SDL_strcmp(arg, "--scene") == 0) && nextarg) {
+            for (scene = 0; scene < SCENE_MAX; scene++) {
+                if (SDL_strcmp(nextarg, scene_names[scene]) == 0) {
+                    break;
+                }
+            }
+            if (scene == SCENE_MAX) {
+                SDL_Log("Unknown scene '%s'", nextarg);
+                return 1;
+            }
+            i++;
+        } else {
+            SDL_Log("USAGE: %s [--tracks N]... [--block FRAMES] [--seconds SECONDS] [--rate HZ] [--channels N] [--scene plain|3d|faded|grouped]", argv[0]);
+            return 1;
+        }
+    }
+
+    if (num_track_counts == 0) {
+        track_counts[num_track_counts++] = 1;
+        track_counts[num_track_counts++] = 8;
+        track_counts[num_track_counts++] = 64;
+    }
+
+    // count every allocation, so we can report how many happen per block. This has to happen before anything else allocates.
+    SDL_GetOriginalMemoryFunctions(&orig_malloc, &orig_calloc, &orig_realloc, &orig_free);
+    SDL_SetMemoryFunctions(CountingMalloc, CountingCalloc, CountingRealloc, CountingFree);
+
+    SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");  // we never open a device, but MIX_Init initializes the audio subsystem.
+
+    if (!MIX_Init()) {
+        SDL_Log("Couldn't initialize SDL_mixer: %s", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Log("Mixing %d channels at %d Hz in blocks of %d frames, %.1f seconds per run", spec.channels, spec.freq, block_frames, seconds);
+
+    bool okay = true;
+    for (int i = 0; okay && (i < SCENE_MAX); i++) {
+        if ((scene < 0) || (scene == i)) {
+            for (int j = 0; okay && (j < num_track_counts); j++) {
+                okay = RunScene((Scene) i, &spec, track_counts[j], block_frames, seconds);
+            }
+        }
+    }
+
+    MIX_Quit();
+    SDL_Quit();
+
+    return okay ? 0 : 1;
+}
@@ -0,0 +1,458 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2026 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "testcorpus.h"
+
+typedef struct SignalState
+{
+    Uint32 noise;
+    int frame;
+} SignalState;
+
+// Test signal: a couple of tones plus a little noise, kept away from full scale so nothing clips.
+static float NextSample(SignalState *state, int channel, int freq)
+{
+    state->noise = (state->noise * 1103515245) + 12345;
+    const float t = (float) state->frame / (float) freq;
+    const float tone = (0.4f * SDL_sinf(2.0f * SDL_PI_F * (channel ? 330.0f : 220.0f) * t)) + (0.2f * SDL_sinf(2.0f * SDL_PI_F * 1234.0f * t));
+    return tone + (0.05f * ((float) ((state->noise >> 16) & 0x7FFF) / 16384.0f - 1.0f));
+}
+
+static Sint16 FloatToS16(float f)
+{
+    return (Sint16) SDL_clamp(SDL_lroundf(f * 32767.0f), -32768, 32767);
+}
+
+// the classic G.711 reference encoders and decoders, on 16-bit linear samples.
+static Uint8 EncodeULaw(Sint16 sample)
+{
+    static const int seg_end[8] = { 0xFF, 0x1FF, 0x3FF, 0x7FF, 0xFFF, 0x1FFF, 0x3FFF, 0x7FFF };
+    int pcm = sample;
+    int mask = 0xFF;
+    if (pcm < 0) {
+        pcm = -pcm;
+        mask = 0x7F;
+    }
+    pcm = SDL_min(pcm, 32635) + 0x84;
+
+    int seg = 0;
+    while ((seg < 8) && (pcm > seg_end[seg])) {
+        seg++;
+    }
+    return (Uint8) (((seg << 4) | ((pcm >> (seg + 3)) & 0xF)) ^ mask);
+}
+
+static Sint16 DecodeULaw(Uint8 ulaw)
+{
+    ulaw = ~ulaw;
+    const int t = (((ulaw & 0xF) << 3) + 0x84) << ((ulaw & 0x70) >> 4);
+    return (Sint16) ((ulaw & 0x80) ? (0x84 - t) : (t - 0x84));
+}
+
+static Uint8 EncodeALaw(Sint16 sample)
+{
+    static const int seg_end[8] = { 0x1F, 0x3F, 0x7F, 0xFF, 0x1FF, 0x3FF, 0x7FF, 0xFFF };
+    int pcm = sample >> 3;
+    int mask = 0xD5;
+    if (pcm < 0) {
+        mask = 0x55;
+        pcm = -pcm - 1;
+    }
+
+    int seg = 0;
+    while ((seg < 8) && (pcm > seg_end[seg])) {
+        seg++;
+    }
+    if (seg >= 8) {
+        return (Uint8) (0x7F ^ mask);
+    }
+    const int aval = (seg << 4) | ((seg < 2) ? ((pcm >> 1) & 0xF) : ((pcm >> seg) & 0xF));
+    return (Uint8) (aval ^ mask);
+}
+
+static Sint16 DecodeALaw(Uint8 alaw)
+{
+    alaw ^= 0x55;
+    int t = (alaw & 0xF) << 4;
+    const int seg = (alaw & 0x70) >> 4;
+    if (seg == 0) {
+        t += 8;
+    } else {
+        t = (t + 0x108) << (seg - 1);
+    }
+    return (Sint16) ((alaw & 0x80) ? t : -t);
+}
+
+static const int ima_index_table[16] = {
+    -1, -1, -1, -1, 2, 4, 6, 8,
+    -1, -1, -1, -1, 2, 4, 6, 8
+};
+
+static const Sint16 ima_step_table[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17,
+    19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118,
+    130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+    337, 371, 408, 449, 494, 544, 598, 658, 724, 796,
+    876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+    2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358,
+    5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+typedef struct IMAState
+{
+    int predictor;
+    int index;
+} IMAState;
+
+// Encode one sample. The updated predictor is exactly what a decoder will reconstruct.
+static Uint8 EncodeIMANibble(IMAState *state, Sint16 sample)
+{
+    const int step = ima_step_table[state->index];
+    int diff = sample - state->predictor;
+    Uint8 nibble = 0;
+    if (diff < 0) {
+        nibble = 8;
+        diff = -diff;
+    }
+
+    int delta = step >> 3;
+    if (diff >= step) { nibble |= 4; diff -= step; delta += step; }
+    if (diff >= (step >> 1)) { nibble |= 2; diff -= step >> 1; delta += step >> 1; }
+    if (diff >= (step >> 2)) { nibble |= 1; delta += step >> 2; }
+
+    state->predictor += (nibble & 8) ? -delta : delta;
+    state->predictor = SDL_clamp(state->predictor, -32768, 32767);
+    state->index = SDL_clamp(state->index + ima_index_table[nibble], 0, 88);
+    return nibble;
+}
+
+static bool FinishFile(TestFile *file, SDL_IOStream *io)
+{
+    // dynamic memory streams own their buffer; take it before closing the stream.
+    const SDL_PropertiesID props = SDL_GetIOProperties(io);
+    file->data = SDL_GetPointerProperty(props, SDL_PROP_IOSTREAM_DYNAMIC_MEMORY_POINTER, NULL);
+    file->datalen = (size_t) SDL_GetIOSize(io);
+    SDL_SetPointerProperty(props, SDL_PROP_IOSTREAM_DYNAMIC_MEMORY_POINTER, NULL);
+    SDL_CloseIO(io);
+    return (file->data != NULL);
+}
+
+static SDL_IOStream *StartFile(TestFile *file, const char *name, int channels, int freq, int seconds)
+{
+    SDL_zerop(file);
+    SDL_strlcpy(file->name, name, sizeof (file->name));
+    file->channels = channels;
+    file->freq = freq;
+    file->frames = freq * seconds;
+    file->reference = (float *) SDL_malloc(sizeof (float) * file->frames * channels);
+    if (!file->reference) {
+        return NULL;
+    }
+    return SDL_IOFromDynamicMem();
+}
+
+static void WriteWAVHeader(SDL_IOStream *io, Uint16 format, int channels, int freq, Uint16 bits, Uint16 blockalign, Uint32 byterate, Uint16 samplesperblock, Uint32 frames, Uint32 datalen)
+{
+    const Uint32 fmtlen = samplesperblock ? 20 : 16;
+    SDL_WriteIO(io, "RIFF", 4);
+    SDL_WriteU32LE(io, 4 + (8 + fmtlen) + (samplesperblock ? 12 : 0) + (8 + datalen));
+    SDL_WriteIO(io, "WAVEfmt ", 8);
+    SDL_WriteU32LE(io, fmtlen);
+    SDL_WriteU16LE(io, format);
+    SDL_WriteU16LE(io, (Uint16) channels);
+    SDL_WriteU32LE(io, (Uint32) freq);
+    SDL_WriteU32LE(io, byterate);
+    SDL_WriteU16LE(io, blockalign);
+    SDL_WriteU16LE(io, bits);
+    if (samplesperblock) {
+        SDL_WriteU16LE(io, 2);  // cbSize
+        SDL_WriteU16LE(io, samplesperblock);
+        SDL_WriteIO(io, "fact", 4);
+        SDL_WriteU32LE(io, 4);
+        SDL_WriteU32LE(io, frames);
+    }
+    SDL_WriteIO(io, "data", 4);
+    SDL_WriteU32LE(io, datalen);
+}
+
+static int EncodingSize(SampleEncoding encoding)
+{
+    switch (encoding) {
+        case ENCODING_S16LE:
+        case ENCODING_S16BE:
+            return 2;
+        case ENCODING_S32LE:
+        case ENCODING_F32LE:
+            return 4;
+        default:
+            break;
+    }
+    return 1;
+}
+
+// Write the test signal as simple PCM, filling in the reference with what each sample should decode to.
+static void WriteSamples(TestFile *file, SDL_IOStream *io, SampleEncoding encoding)
+{
+    SignalState signal = { 0x12345678, 0 };
+    float *ref = file->reference;
+    for (int i = 0; i < file->frames; i++, signal.frame++) {
+        for (int j = 0; j < file->channels; j++) {
+            const float f = NextSample(&signal, j, file->freq);
+            switch (encoding) {
+                case ENCODING_U8: {
+                    const Uint8 u8 = (Uint8) SDL_clamp(SDL_lroundf(f * 127.0f) + 128, 0, 255);
+                    SDL_WriteU8(io, u8);
+                    *(ref++) = (float) (u8 - 128) / 128.0f;
+                    break;
+                }
+
+                case ENCODING_S16LE:
+                case ENCODING_S16BE: {
+                    const Sint16 s16 = FloatToS16(f);
+                    if (encoding == ENCODING_S16LE) {
+                        SDL_WriteS16LE(io, s16);
+                    } else {
+                        SDL_WriteS16BE(io, s16);
+                    }
+                    *(ref++) = (float) s16 / 32768.0f;
+                    break;
+                }
+
+                case ENCODING_S32LE: {
+                    const Sint32 s32 = (Sint32) ((double) f * 2147483647.0);
+                    SDL_WriteS32LE(io, s32);
+                    file->tolerance = 2.0f / 8388608.0f;  // converting to float keeps 24 bits.
+                    *(ref++) = (float) ((double) s32 / 2147483648.0);
+                    break;
+                }
+
+                case ENCODING_F32LE: {
+                    union { float f; Uint32 ui32; } cvt;
+                    cvt.f = f;
+                    SDL_WriteU32LE(io, cvt.ui32);
+                    *(ref++) = f;
+                    break;
+                }
+
+                case ENCODING_ULAW: {
+                    const Uint8 ulaw = EncodeULaw(FloatToS16(f));
+                    SDL_WriteU8(io, ulaw);
+                    *(ref++) = (float) DecodeULaw(ulaw) / 32768.0f;
+                    break;
+                }
+
+                case ENCODING_ALAW: {
+                    const Uint8 alaw = EncodeALaw(FloatToS16(f));
+                    SDL_WriteU8(io, alaw);
+                    *(ref++) = (float) DecodeALaw(alaw) / 32768.0f;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+bool GenerateWAV(TestFile *file, const char *name, SampleEncoding encoding, int channels, int freq, int seconds)
+{
+    SDL_IOStream *io = StartFile(file, name, channels, freq, seconds);
+    if (!io) {
+        return false;
+    }
+
+    Uint16 format = 1;  // PCM
+    if (encoding == ENCODING_F32LE) {
+        format = 3;
+    } else if (encoding == ENCODING_ALAW) {
+        format = 6;
+    } else if (encoding == ENCODING_ULAW) {
+        format = 7;
+    }
+
+    const Uint16 blockalign = (Uint16) (channels * EncodingSize(encoding));
+    const Uint32 frames = (Uint32) file->frames;
+    WriteWAVHeader(io, format, channels, freq, (Uint16) (EncodingSize(encoding) * 8), blockalign, freq * blockalign, 0, frames, frames * blockalign);
+    WriteSamples(file, io, encoding);
+    return FinishFile(file, io);
+}
+
+bool GenerateIMAADPCMWAV(TestFile *file, const char *name, int channels, int freq, int seconds)
+{
+    SDL_IOStream *io = StartFile(file, name, channels, freq, seconds);
+    if (!io) {
+        return false;
+    }
+
+    const Uint16 blockalign = (Uint16) (512 * channels);
+    const Uint16 samplesperblock = (Uint16) ((((blockalign - (4 * channels)) * 8) / (4 * channels)) + 1);
+    const int blocks = file->frames / samplesperblock;  // only whole blocks, so trim the reference to match.
+    file->frames = blocks * samplesperblock;
+
+    WriteWAVHeader(io, 0x0011, channels, freq, 4, blockalign, (Uint32) (((Uint64) freq * blockalign) / samplesperblock), samplesperblock, (Uint32) file->frames, (Uint32) (blocks * blockalign));
+
+    // generate the whole signal first, since each block encodes a channel's samples in runs of 8.
+    SignalState signal = { 0x12345678, 0 };
+    Sint16 *pcm = (Sint16 *) SDL_malloc(sizeof (Sint16) * file->frames * channels);
+    if (!pcm) {
+        SDL_CloseIO(io);
+        return false;
+    }
+    for (int i = 0; i < file->frames; i++, signal.frame++) {
+        for (int j = 0; j < channels; j++) {
+            pcm[(i * channels) + j] = FloatToS16(NextSample(&signal, j, freq));
+        }
+    }
+
+    IMAState state[2];
+    SDL_zeroa(state);
+
+    int frame = 0;
+    for (int block = 0; block < blocks; block++) {
+        // block header: the first sample is stored whole, per channel.
+        for (int j = 0; j < channels; j++) {
+            state[j].predictor = pcm[(frame * channels) + j];
+            file->reference[(frame * channels) + j] = (float) state[j].predictor / 32768.0f;
+            SDL_WriteS16LE(io, (Sint16) state[j].predictor);
+            SDL_WriteU8(io, (Uint8) state[j].index);
+            SDL_WriteU8(io, 0);
+        }
+        frame++;
+
+        // then each channel gets 8 samples (4 bytes) at a time, interleaved.
+        for (int i = 1; i < samplesperblock; i += 8) {
+            for (int j = 0; j < channels; j++) {
+                for (int k = 0; k < 8; k += 2) {
+                    const int lo_idx = ((frame + k) * channels) + j;
+                    const int hi_idx = lo_idx + channels;
+                    const Uint8 lo = EncodeIMANibble(&state[j], pcm[lo_idx]);
+                    file->reference[lo_idx] = (float) state[j].predictor / 32768.0f;
+                    const Uint8 hi = EncodeIMANibble(&state[j], pcm[hi_idx]);
+                    file->reference[hi_idx] = (float) state[j].predictor / 32768.0f;
+                    SDL_WriteU8(io, (Uint8) (lo | (hi << 4)));
+                }
+            }
+            frame += 8;
+        }
+    }
+
+    SDL_free(pcm);
+    return FinishFile(file, io);
+}
+
+bool GenerateAIFF(TestFile *file, const char *name, int channels, int freq, int seconds)
+{
+    SDL_IOStream *io = StartFile(file, name, channels, freq, seconds);
+    if (!io) {
+        return false;
+    }
+
+    const Uint32 frames = (Uint32) file->frames;
+    const Uint32 datalen = frames * channels * 2;
+
+    // AIFF stores the sample rate as an 80-bit IEEE extended float. For integer rates that's easy to build by hand.
+    int exponent = 0;
+    while ((exponent < 31) && (((Uint32) freq >> (exponent + 1)) != 0)) {
+        exponent++;
+    }
+
+    SDL_WriteIO(io, "FORM", 4);
+    SDL_WriteU32BE(io, 4 + (8 + 18) + (8 + 8 + datalen));
+    SDL_WriteIO(io, "AIFFCOMM", 8);
+    SDL_WriteU32BE(io, 18);
+    SDL_WriteU16BE(io, (Uint16) channels);
+    SDL_WriteU32BE(io, frames);
+    SDL_WriteU16BE(io, 16);
+    SDL_WriteU16BE(io, (Uint16) (16383 + exponent));
+    SDL_WriteU64BE(io, ((Uint64) freq) << (63 - exponent));
+    SDL_WriteIO(io, "SSND", 4);
+    SDL_WriteU32BE(io, 8 + datalen);
+    SDL_WriteU32BE(io, 0);  // offset
+    SDL_WriteU32BE(io, 0);  // block size
+    WriteSamples(file, io, ENCODING_S16BE);
+    return FinishFile(file, io);
+}
+
+bool GenerateAU(TestFile *file, const char *name, SampleEncoding encoding, int channels, int freq, int seconds)
+{
+    SDL_IOStream *io = StartFile(file, name, channels, freq, seconds);
+    if (!io) {
+        return false;
+    }
+
+    SDL_WriteU32BE(io, 0x2E736E64);  // ".snd"
+    SDL_WriteU32BE(io, 24);  // header size
+    SDL_WriteU32BE(io, (Uint32) (file->frames * channels * EncodingSize(encoding)));
+    SDL_WriteU32BE(io, (encoding == ENCODING_ULAW) ? 1 : 3);  // 8-bit u-law or 16-bit linear
+    SDL_WriteU32BE(io, (Uint32) freq);
+    SDL_WriteU32BE(io, (Uint32) channels);
+    WriteSamples(file, io, encoding);
+    return FinishFile(file, io);
+}
+
+bool GenerateVOC(TestFile *file, const char *name, SampleEncoding encoding, int channels, int freq, int seconds)
+{
+    SDL_IOStream *io = StartFile(file, name, channels, freq, seconds);
+    if (!io) {
+        return false;
+    }
+
+    const Uint32 datalen = (Uint32) (file->frames * channels * EncodingSize(encoding));
+    const Uint32 blocklen = 12 + datalen;  // has to fit in 24 bits.
+
+    SDL_WriteIO(io, "Creative Voice File\032", 20);
+    SDL_WriteU16LE(io, 26);  // offset of the first data block
+    SDL_WriteU16LE(io, 0x0114);  // version 1.20
+    SDL_WriteU16LE(io, (Uint16) (~0x0114 + 0x1234));
+    SDL_WriteU8(io, 9);  // a "new format" data block, which stores the rate and channels directly.
+    SDL_WriteU8(io, (Uint8) (blocklen & 0xFF));
+    SDL_WriteU8(io, (Uint8) ((blocklen >> 8) & 0xFF));
+    SDL_WriteU8(io, (Uint8) ((blocklen >> 16) & 0xFF));
+    SDL_WriteU32LE(io, (Uint32) freq);
+    SDL_WriteU8(io, (Uint8) (EncodingSize(encoding) * 8));
+    SDL_WriteU8(io, (Uint8) channels);
+    SDL_WriteU16LE(io, (encoding == ENCODING_U8) ? 0 : 4);  // 8-bit unsigned or 16-bit signed
+    SDL_WriteU32LE(io, 0);  // reserved
+    WriteSamples(file, io, encoding);
+    SDL_WriteU8(io, 0);  // terminator block
+    return FinishFile(file, io);
+}
+
+bool GenerateRaw(TestFile *file, const char *name, int channels, int freq, int seconds)
+{
+    SDL_IOStream *io = StartFile(file, name, channels, freq, seconds);
+    if (!io) {
+        return false;
+    }
+
+    file->raw_spec.format = SDL_AUDIO_S16LE;
+    file->raw_spec.channels = channels;
+    file->raw_spec.freq = freq;
+    WriteSamples(file, io, ENCODING_S16LE);
+    return FinishFile(file, io);
+}
+
+void FreeTestFile(TestFile *file)
+{
+    SDL_free(file->data);
+    SDL_free(file->reference);
+    SDL_zerop(file);
+}
@@ -0,0 +1,67 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2026 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+/*
+  Test file generators shared by the test programs. Each one synthesizes the
+  same test signal (a couple of tones plus a little noise) in some container
+  and encoding, entirely in memory, and records what a correct decoder should
+  produce from it, so results can be checked exactly.
+*/
+
+#ifndef TESTCORPUS_H_
+#define TESTCORPUS_H_
+
+#include <SDL3/SDL.h>
+
+typedef enum SampleEncoding
+{
+    ENCODING_U8,
+    ENCODING_S16LE,
+    ENCODING_S16BE,
+    ENCODING_S32LE,
+    ENCODING_F32LE,
+    ENCODING_ULAW,
+    ENCODING_ALAW
+} SampleEncoding;
+
+typedef struct TestFile
+{
+    char name[64];
+    int channels;
+    int freq;
+    int frames;
+    void *data;  // the encoded file, or just PCM for raw audio.
+    size_t datalen;
+    SDL_AudioSpec raw_spec;  // format is non-zero for raw audio.
+    float *reference;  // what the data should decode to, as interleaved float32. NULL for files not generated here.
+    float tolerance;  // how far a correct decode may stray from the reference, beyond float32 rounding.
+} TestFile;
+
+// All of these return false on failure; call SDL_GetError() for more information. Free the result with FreeTestFile().
+extern bool GenerateWAV(TestFile *file, const char *name, SampleEncoding encoding, int channels, int freq, int seconds);
+extern bool GenerateIMAADPCMWAV(TestFile *file, const char *name, int channels, int freq, int seconds);
+extern bool GenerateAIFF(TestFile *file, const char *name, int channels, int freq, int seconds);
+extern bool GenerateAU(TestFile *file, const char *name, SampleEncoding encoding, int channels, int freq, int seconds);
+extern bool GenerateVOC(TestFile *file, const char *name, SampleEncoding encoding, int channels, int freq, int seconds);
+extern bool GenerateRaw(TestFile *file, const char *name, int channels, int freq, int seconds);  // fills in raw_spec.
+extern void FreeTestFile(TestFile *file);
+
+#endif /* TESTCORPUS_H_ */
@@ -0,0 +1,338 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2026 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+/*
+  This is a regression test for decoding and mixing. It synthesizes a test
+  signal in every container SDL_mixer reads natively (WAV as PCM, float,
+  u-law, a-law and IMA ADPCM; AIFF; AU; VOC; raw PCM), renders each one
+  offline with MIX_RenderAudio(), and checks the result:
+
+  - Each file is played through a mixer at its own rate and channel count,
+    so no resampling happens, and compared sample-by-sample against what the
+    encoded data should decode to.
+  - Each file is rendered twice, in one call and in small odd-sized blocks,
+    and the two must match bit-for-bit.
+  - All files are then mixed together, resampled to 48000Hz stereo. This
+    scene has no exact reference, so its RMS and peak are compared against a
+    golden file, within a tolerance. Run with --record FILE once on a known
+    good build to write the golden file, then --golden FILE to check.
+
+  It also reports how long each render took, so fast-path changes come with
+  both proof that output didn't drift and how much faster they are.
+
+  The exit code is zero if everything passed.
+*/
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include "SDL3_mixer/SDL_mixer.h"
+#include "testcorpus.h"
+
+#define BLOCK_FRAMES 997  // deliberately odd, so blocks don't line up with anything.
+#define SCENE_FREQ 48000
+#define SCENE_CHANNELS 2
+#define GOLDEN_TOLERANCE 0.0001
+
+static MIX_Audio *LoadCase(MIX_Mixer *mixer, const TestFile *file)
+{
+    if (file->raw_spec.format) {
+        return MIX_LoadRawAudio(mixer, file->data, file->datalen, &file->raw_spec);
+    }
+    return MIX_LoadAudio_IO(mixer, SDL_IOFromConstMem(file->data, file->datalen), false, true);
+}
+
+// Render `audio` through `mixer` into `buffer`, `block_frames` at a time. Returns the number of real frames mixed, or -1 on error.
+static int RenderTrack(MIX_Mixer *mixer, MIX_Audio *audio, float *buffer, int frames, int channels, int block_frames, Uint64 *elapsed_ns)
+{
+    MIX_Track *track = MIX_CreateTrack(mixer);
+    if (!track) {
+        return -1;
+    } else if (!MIX_SetTrackAudio(track, audio) || !MIX_PlayTrack(track, 0)) {
+        MIX_DestroyTrack(track);
+        return -1;
+    }
+
+    int retval = 0;
+    const Uint64 start = SDL_GetTicksNS();
+    for (int offset = 0; offset < frames; offset += block_frames) {
+        const int rc = MIX_RenderAudio(mixer, buffer + ((size_t) offset * channels), SDL_min(block_frames, frames - offset));
+        if (rc < 0) {
+            retval = -1;
+            break;
+        } else if (rc > 0) {
+            retval = offset + rc;
+        }
+    }
+    *elapsed_ns += SDL_GetTicksNS() - start;
+
+    MIX_DestroyTrack(track);
+    return retval;
+}
+
+static bool TestCase(const TestFile *file)
+{
+    bool retval = false;
+    const SDL_AudioSpec spec = { SDL_AUDIO_F32, file->channels, file->freq };
+    const size_t bufsize = sizeof (float) * file->frames * file->channels;
+    float *whole = (float *) SDL_malloc(bufsize);
+    float *blocks = (float *) SDL_malloc(bufsize);
+    MIX_Mixer *mixer = MIX_CreateMixer(&spec);
+    MIX_Audio *audio = mixer ? LoadCase(mixer, file) : NULL;
+    Uint64 elapsed_ns = 0;
+
+    if (!whole || !blocks || !mixer || !audio) {
+        SDL_Log("%-16s FAIL: couldn't set up: %s", file->name, SDL_GetError());
+        goto done;
+    }
+
+    const int whole_frames = RenderTrack(mixer, audio, whole, file->frames, file->channels, file->frames, &elapsed_ns);
+    const int blocks_frames = RenderTrack(mixer, audio, blocks, file->frames, file->channels, BLOCK_FRAMES, &elapsed_ns);
+    if ((whole_frames < 0) || (blocks_frames < 0)) {
+        SDL_Log("%-16s FAIL: render failed: %s", file->name, SDL_GetError());
+        goto done;
+    } else if (whole_frames != file->frames) {
+        SDL_Log("%-16s FAIL: rendered %d frames, expected %d", file->name, whole_frames, file->frames);
+        goto done;
+    } else if ((blocks_frames != whole_frames) || (SDL_memcmp(whole, blocks, bufsize) != 0)) {
+        SDL_Log("%-16s FAIL: rendering in %d-frame blocks changed the output", file->name, BLOCK_FRAMES);
+        goto done;
+    }
+
+    float max_error = 0.0f;
+    int max_error_sample = 0;
+    const int samples = file->frames * file->channels;
+    for (int i = 0; i < samples; i++) {
+        const float error = SDL_fabsf(whole[i] - file->reference[i]);
+        if (error > max_error) {
+            max_error = error;
+            max_error_sample = i;
+        }
+    }
+
+    // anything decoded exactly should match to within float32 conversion error.
+    const float tolerance = SDL_max(file->tolerance, 1.0f / 16777216.0f);
+    const double seconds = (double) elapsed_ns / (double) SDL_NS_PER_SECOND;
+    const double realtime = (seconds > 0.0) ? ((2.0 * file->frames / file->freq) / seconds) : 0.0;
+    if (max_error > tolerance) {
+        SDL_Log("%-16s FAIL: sample %d is off by %g (got %g, expected %g)", file->name, max_error_sample, max_error, whole[max_error_sample], file->reference[max_error_sample]);
+        goto done;
+    }
+
+    SDL_Log("%-16s ok    max error %-10g %8.2f ms %10.1fx realtime", file->name, max_error, seconds * 1000.0, realtime);
+    retval = true;
+
+done:
+    MIX_DestroyAudio(audio);
+    MIX_DestroyMixer(mixer);
+    SDL_free(blocks);
+    SDL_free(whole);
+    return retval;
+}
+
+// Mix everything at once, resampled, and return the result's RMS and peak.
+static bool RenderScene(const TestFile *cases, int num_cases, int frames, double *rms, double *peak)
+{
+    const SDL_AudioSpec spec = { SDL_AUDIO_F32, SCENE_CHANNELS, SCENE_FREQ };
+    MIX_Mixer *mixer = MIX_CreateMixer(&spec);
+    float *buffer = (float *) SDL_malloc(sizeof (float) * frames * SCENE_CHANNELS);
+    MIX_Audio **audio = (MIX_Audio **) SDL_calloc(num_cases, sizeof (MIX_Audio *));
+    bool retval = false;
+
+    if (!mixer || !buffer || !audio) {
+        goto done;
+    }
+
+    MIX_SetMixerGain(mixer, 1.0f / (float) num_cases);
+
+    for (int i = 0; i < num_cases; i++) {
+        audio[i] = LoadCase(mixer, &cases[i]);
+        if (!audio[i] || !MIX_PlayAudio(mixer, audio[i])) {
+            goto done;
+        }
+    }
+
+    const Uint64 start = SDL_GetTicksNS();
+    for (int offset = 0; offset < frames; offset += BLOCK_FRAMES) {
+        if (MIX_RenderAudio(mixer, buffer + ((size_t) offset * SCENE_CHANNELS), SDL_min(BLOCK_FRAMES, frames - offset)) < 0) {
+            goto done;
+        }
+    }
+    const Uint64 elapsed_ns = SDL_GetTicksNS() - start;
+
+    double sum = 0.0;
+    *peak = 0.0;
+    for (int i = 0; i < frames * SCENE_CHANNELS; i++) {
+        const double sample = (double) buffer[i];
+        sum += sample * sample;
+        *peak = SDL_max(*peak, SDL_fabs(sample));
+    }
+    *rms = SDL_sqrt(sum / (double) (frames * SCENE_CHANNELS));
+
+    SDL_Log("%-16s rendered %d tracks in %.2f ms", "scene", num_cases, (double) elapsed_ns / (double) SDL_NS_PER_MS);
+    retval = true;
+
+done:
+    if (audio) {
+        for (int i = 0; i < num_cases; i++) {
+            MIX_DestroyAudio(audio[i]);
+        }
+    }
+    SDL_free(audio);
+    SDL_free(buffer);
+    MIX_DestroyMixer(mixer);
+    return retval;
+}
+
+// The golden file is one line per value: "name value [tolerance]". It's plain text so changes show up clearly in diffs.
+//  Lines that don't match a name, like comments, are ignored.
+static bool CheckGoldenValue(const char *golden, const char *name, double value)
+{
+    const size_t namelen = SDL_strlen(name);
+    const char *line = golden;
+    while (line && *line) {
+        if ((SDL_strncmp(line, name, namelen) == 0) && (line[namelen] == ' ')) {
+            char *endp = NULL;
+            const double expected = SDL_strtod(line + namelen + 1, &endp);
+            double tolerance = GOLDEN_TOLERANCE;
+            if (endp && (*endp == ' ')) {
+                tolerance = SDL_strtod(endp + 1, NULL);
+            }
+            const double error = SDL_fabs(value - expected);
+            if (error > (tolerance * SDL_max(SDL_fabs(expected), 1.0))) {
+                SDL_Log("%-16s FAIL: %s is %.9g, golden file says %.9g", "scene", name, value, expected);
+                return false;
+            }
+            return true;
+        }
+        line = SDL_strchr(line, '\n');
+        if (line) {
+            line++;
+        }
+    }
+    SDL_Log("%-16s FAIL: golden file has no %s", "scene", name);
+    return false;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *golden_path = NULL;
+    const char *record_path = NULL;
+    int seconds = 2;
+    int failures = 0;
+
+    SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");  // we never open a device, but MIX_Init initializes the audio subsystem.
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        if ((SDL_strcmp(arg, "--golden") == 0) && (i < (argc - 1))) {
+            golden_path = argv[++i];
+        } else if ((SDL_strcmp(arg, "--record") == 0) && (i < (argc - 1))) {
+            record_path = argv[++i];
+        } else if ((SDL_strcmp(arg, "--seconds") == 0) && (i < (argc - 1))) {
+            seconds = SDL_max(SDL_atoi(argv[++i]), 1);
+        } else {
+            SDL_Log("USAGE: %s [--seconds N] [--golden FILE] [--record FILE]", argv[0]);
+            return 1;
+        }
+    }
+
+    if (!MIX_Init()) {
+        SDL_Log("Couldn't initialize SDL_mixer: %s", SDL_GetError());
+        return 1;
+    }
+
+    TestFile cases[13];
+    SDL_zeroa(cases);
+
+    int num_cases = 0;
+    bool okay = true;
+    okay = okay && GenerateWAV(&cases[num_cases++], "wav-u8", ENCODING_U8, 1, 22050, seconds);
+    okay = okay && GenerateWAV(&cases[num_cases++], "wav-s16", ENCODING_S16LE, 2, 44100, seconds);
+    okay = okay && GenerateWAV(&cases[num_cases++], "wav-s32", ENCODING_S32LE, 2, 48000, seconds);
+    okay = okay && GenerateWAV(&cases[num_cases++], "wav-f32", ENCODING_F32LE, 2, 48000, seconds);
+    okay = okay && GenerateWAV(&cases[num_cases++], "wav-ulaw", ENCODING_ULAW, 1, 8000, seconds);
+    okay = okay && GenerateWAV(&cases[num_cases++], "wav-alaw", ENCODING_ALAW, 1, 8000, seconds);
+    okay = okay && GenerateIMAADPCMWAV(&cases[num_cases++], "wav-ima-adpcm", 2, 44100, seconds);
+    okay = okay && GenerateAIFF(&cases[num_cases++], "aiff-s16", 2, 44100, seconds);
+    okay = okay && GenerateAU(&cases[num_cases++], "au-s16", ENCODING_S16BE, 1, 22050, seconds);
+    okay = okay && GenerateAU(&cases[num_cases++], "au-ulaw", ENCODING_ULAW, 1, 8000, seconds);
+    okay = okay && GenerateVOC(&cases[num_cases++], "voc-u8", ENCODING_U8, 1, 22050, seconds);
+    okay = okay && GenerateVOC(&cases[num_cases++], "voc-s16", ENCODING_S16LE, 2, 44100, seconds);
+    okay = okay && GenerateRaw(&cases[num_cases++], "raw-s16", 2, 44100, seconds);
+
+    if (!okay) {
+        SDL_Log("Couldn't generate test files: %s", SDL_GetError());
+        for (int i = 0; i < num_cases; i++) {
+            FreeTestFile(&cases[i]);  // the one that failed is safe to free, too.
+        }
+        MIX_Quit();
+        SDL_Quit();
+        return 1;
+    }
+
+    for (int i = 0; i < num_cases; i++) {
+        if (!TestCase(&cases[i])) {
+            failures++;
+        }
+    }
+
+    double rms = 0.0, peak = 0.0;
+    if (!RenderScene(cases, num_cases, SCENE_FREQ * seconds, &rms, &peak)) {
+        SDL_Log("%-16s FAIL: %s", "scene", SDL_GetError());
+        failures++;
+    } else {
+        SDL_Log("%-16s rms %.9g, peak %.9g", "scene", rms, peak);
+
+        if (record_path) {
+            SDL_IOStream *io = SDL_IOFromFile(record_path, "w");
+            if (!io || !SDL_IOprintf(io, "seconds %d\nrms %.9g\npeak %.9g\n", seconds, rms, peak)) {
+                SDL_Log("Couldn't write '%s': %s", record_path, SDL_GetError());
+                failures++;
+            }
+            SDL_CloseIO(io);
+        }
+
+        if (golden_path) {
+            char *golden = (char *) SDL_LoadFile(golden_path, NULL);
+            if (!golden) {
+                SDL_Log("Couldn't load '%s': %s", golden_path, SDL_GetError());
+                failures++;
+            } else {
+                if (!CheckGoldenValue(golden, "seconds", (double) seconds) ||
+                    !CheckGoldenValue(golden, "rms", rms) ||
+                    !CheckGoldenValue(golden, "peak", peak)) {
+                    failures++;
+                }
+                SDL_free(golden);
+            }
+        }
+    }
+
+    for (int i = 0; i < num_cases; i++) {
+        FreeTestFile(&cases[i]);
+    }
+
+    MIX_Quit();
+    SDL_Quit();
+
+    SDL_Log("%d failure%s.", failures, (failures == 1) ? "" : "s");
+    return (failures == 0) ? 0 : 1;
+}